@@ -0,0 +1,352 @@
+#ifndef INDEX_TREE_H
+#define INDEX_TREE_H
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include "Tree.h"
+using namespace std;
+
+// ڵͣ32λ±64λָ
+typedef unsigned int NodeIdx;
+const NodeIdx NIL = 0xFFFFFFFFu;  // 
+
+// նڵ㣺ӾΪ32λ±
+template <typename T>
+struct IndexNode {
+    T data;          // ڵ
+    NodeIdx left;    // ӽڵ±
+    NodeIdx right;   // ӽڵ±
+    NodeIdx parent;  // ڵ±
+
+    IndexNode(const T& e = T(), NodeIdx p = NIL)
+        : data(e), left(NIL), right(NIL), parent(p) {}
+};
+
+// ±ʽģ壺нڵһУӿTreeһ
+// ڵNodeIdxʶɾĽڵleftֶδ븴
+template <typename T>
+class IndexTree {
+protected:
+    vector<IndexNode<T> > _nodes;  // ڵ
+    NodeIdx _root;                 // ڵ±
+    NodeIdx _free;                 // ͷ
+    int _size;                     // ĹģЧڵ
+
+    // һڵ㣺ȸÿвλ
+    NodeIdx newNode(const T& e, NodeIdx parent) {
+        if (_free != NIL) {
+            NodeIdx i = _free;
+            _free = _nodes[i].left;
+            _nodes[i] = IndexNode<T>(e, parent);
+            return i;
+        }
+        _nodes.push_back(IndexNode<T>(e, parent));
+        return (NodeIdx)(_nodes.size() - 1);
+    }
+
+    // һڵ㵽
+    void freeNode(NodeIdx i) {
+        _nodes[i] = IndexNode<T>();
+        _nodes[i].left = _free;
+        _free = i;
+    }
+
+    // iΪУĵһڵ
+    NodeIdx firstPost(NodeIdx i) const {
+        while (true) {
+            if (_nodes[i].left != NIL) i = _nodes[i].left;
+            else if (_nodes[i].right != NIL) i = _nodes[i].right;
+            else return i;
+        }
+    }
+
+    // iΪУĵһڵ
+    NodeIdx firstIn(NodeIdx i) const {
+        while (_nodes[i].left != NIL) i = _nodes[i].left;
+        return i;
+    }
+
+public:
+    // 캯ʼ
+    IndexTree() : _root(NIL), _free(NIL), _size(0) {}
+
+    // ָʽTreeתǰαţ
+    IndexTree(const Tree<T>& t) : _root(NIL), _free(NIL), _size(0) {
+        _nodes.reserve(t.size());
+        if (t.root() == NULL) return;
+        vector<pair<TreeNode<T>*, NodeIdx> > stk;  // (Դڵ, ¸ڵ)
+        stk.push_back(make_pair(t.root(), NIL));
+        while (!stk.empty()) {
+            TreeNode<T>* p = stk.back().first;
+            NodeIdx parent = stk.back().second;
+            stk.pop_back();
+            NodeIdx i = newNode(p->data, parent);
+            _size++;
+            if (parent == NIL) _root = i;
+            else if (p->parent->left == p) _nodes[parent].left = i;
+            else _nodes[parent].right = i;
+            if (p->right != NULL) stk.push_back(make_pair(p->right, i));
+            if (p->left != NULL) stk.push_back(make_pair(p->left, i));
+        }
+    }
+
+    // ԤnڵĿռ
+    void reserve(int n) {
+        _nodes.reserve(n);
+    }
+
+    // ڵ㣬¸
+    NodeIdx insertRoot(const T& e) {
+        if (_root != NIL) {
+            cerr << "Error: Root already exists." << endl;
+            return NIL;
+        }
+        _root = newNode(e, NIL);
+        _size++;
+        return _root;
+    }
+
+    // ڵΪpӽڵ㣬½ڵ
+    NodeIdx insertLeft(NodeIdx p, const T& e) {
+        if (p == NIL) return NIL;
+        if (_nodes[p].left != NIL) {
+            cerr << "Error: Left child already exists." << endl;
+            return NIL;
+        }
+        NodeIdx i = newNode(e, p);  // ʹ_nodesݣ֮дp
+        _nodes[p].left = i;
+        _size++;
+        return i;
+    }
+
+    // ڵΪpӽڵ㣬½ڵ
+    NodeIdx insertRight(NodeIdx p, const T& e) {
+        if (p == NIL) return NIL;
+        if (_nodes[p].right != NIL) {
+            cerr << "Error: Right child already exists." << endl;
+            return NIL;
+        }
+        NodeIdx i = newNode(e, p);
+        _nodes[p].right = i;
+        _size++;
+        return i;
+    }
+
+    // ɾpΪرɾڵ
+    int remove(NodeIdx p) {
+        if (p == NIL) return 0;
+        NodeIdx parent = _nodes[p].parent;
+        if (parent == NIL) _root = NIL;
+        else if (_nodes[parent].left == p) _nodes[parent].left = NIL;
+        else _nodes[parent].right = NIL;
+
+        // գֻڵ㣬ʿٻյǰڵ
+        int count = 0;
+        NodeIdx i = firstPost(p);
+        while (true) {
+            NodeIdx next = NIL;
+            if (i != p) {
+                NodeIdx q = _nodes[i].parent;
+                if (_nodes[q].left == i && _nodes[q].right != NIL) next = firstPost(_nodes[q].right);
+                else next = q;
+            }
+            freeNode(i);
+            count++;
+            if (next == NIL) break;
+            i = next;
+        }
+        _size -= count;
+        return count;
+    }
+
+    // ԪeӽڵpʼĬϴӸڵ㿪ʼǰ򷵻صһƥ
+    NodeIdx find(const T& e, NodeIdx p = NIL) const {
+        if (p == NIL) p = _root;
+        NodeIdx stop = p;
+        while (p != NIL) {
+            if (_nodes[p].data == e) return p;
+            p = nextPreOrder(p, stop);
+        }
+        return NIL;
+    }
+
+    // stopΪڣiǰ̣򷵻NIL
+    NodeIdx nextPreOrder(NodeIdx i, NodeIdx stop) const {
+        if (_nodes[i].left != NIL) return _nodes[i].left;
+        if (_nodes[i].right != NIL) return _nodes[i].right;
+        while (i != stop) {
+            NodeIdx p = _nodes[i].parent;
+            if (_nodes[p].left == i && _nodes[p].right != NIL) return _nodes[p].right;
+            i = p;
+        }
+        return NIL;
+    }
+
+    // ǰ--ңӵݹջ
+    void preOrder(NodeIdx p, void (*visit)(T&)) {
+        for (NodeIdx i = p, stop = p; i != NIL; i = nextPreOrder(i, stop)) {
+            visit(_nodes[i].data);
+        }
+    }
+
+    void preOrder(void (*visit)(T&)) {
+        if (_root != NIL) preOrder(_root, visit);
+    }
+
+    // ͨʣЯ״̬ͣ
+    template <typename VST>
+    void preOrder(NodeIdx p, VST& visit) {
+        for (NodeIdx i = p, stop = p; i != NIL; i = nextPreOrder(i, stop)) {
+            visit(_nodes[i].data);
+        }
+    }
+
+    template <typename VST>
+    void preOrder(VST& visit) {
+        if (_root != NIL) preOrder(_root, visit);
+    }
+
+    // --
+    void inOrder(NodeIdx p, void (*visit)(T&)) {
+        if (p == NIL) return;
+        NodeIdx i = firstIn(p);
+        while (i != NIL) {
+            visit(_nodes[i].data);
+            if (_nodes[i].right != NIL) {
+                i = firstIn(_nodes[i].right);
+                continue;
+            }
+            // ϻݣֱصĳ
+            while (i != p && _nodes[_nodes[i].parent].right == i) i = _nodes[i].parent;
+            i = (i == p) ? NIL : _nodes[i].parent;
+        }
+    }
+
+    void inOrder(void (*visit)(T&)) {
+        inOrder(_root, visit);
+    }
+
+    template <typename VST>
+    void inOrder(NodeIdx p, VST& visit) {
+        if (p == NIL) return;
+        NodeIdx i = firstIn(p);
+        while (i != NIL) {
+            visit(_nodes[i].data);
+            if (_nodes[i].right != NIL) {
+                i = firstIn(_nodes[i].right);
+                continue;
+            }
+            while (i != p && _nodes[_nodes[i].parent].right == i) i = _nodes[i].parent;
+            i = (i == p) ? NIL : _nodes[i].parent;
+        }
+    }
+
+    template <typename VST>
+    void inOrder(VST& visit) {
+        inOrder(_root, visit);
+    }
+
+    // --
+    void postOrder(NodeIdx p, void (*visit)(T&)) {
+        if (p == NIL) return;
+        NodeIdx i = firstPost(p);
+        while (true) {
+            visit(_nodes[i].data);
+            if (i == p) break;
+            NodeIdx q = _nodes[i].parent;
+            if (_nodes[q].left == i && _nodes[q].right != NIL) i = firstPost(_nodes[q].right);
+            else i = q;
+        }
+    }
+
+    void postOrder(void (*visit)(T&)) {
+        postOrder(_root, visit);
+    }
+
+    template <typename VST>
+    void postOrder(NodeIdx p, VST& visit) {
+        if (p == NIL) return;
+        NodeIdx i = firstPost(p);
+        while (true) {
+            visit(_nodes[i].data);
+            if (i == p) break;
+            NodeIdx q = _nodes[i].parent;
+            if (_nodes[q].left == i && _nodes[q].right != NIL) i = firstPost(_nodes[q].right);
+            else i = q;
+        }
+    }
+
+    template <typename VST>
+    void postOrder(VST& visit) {
+        postOrder(_root, visit);
+    }
+
+    // ڵʽӿ
+    T& data(NodeIdx i) { return _nodes[i].data; }
+    const T& data(NodeIdx i) const { return _nodes[i].data; }
+    NodeIdx left(NodeIdx i) const { return _nodes[i].left; }
+    NodeIdx right(NodeIdx i) const { return _nodes[i].right; }
+    NodeIdx parent(NodeIdx i) const { return _nodes[i].parent; }
+
+    // ȡĹģ
+    int size() const {
+        return _size;
+    }
+
+    // жǷΪ
+    bool empty() const {
+        return _size == 0;
+    }
+
+    // ȡڵ
+    NodeIdx root() const {
+        return _root;
+    }
+
+    // ڵռõֽ
+    size_t memoryUsage() const {
+        return _nodes.capacity() * sizeof(IndexNode<T>);
+    }
+
+    // ӡǰʽ
+    void print() {
+        cout << "IndexTree [size=" << _size << "]: ";
+        preOrder(printElem);
+        cout << endl;
+    }
+};
+
+// ʱۼԪأܲʹã
+struct SumVisitor {
+    long long sum;
+    SumVisitor() : sum(0) {}
+    void operator()(const int& e) { sum += e; }
+};
+
+// ܲԣȽָʽTree±ʽIndexTreeڴռٶ
+inline void benchIndexTree(int n = 1000000, int rounds = 10) {
+    cout << "=== ±ʽ" << n << "ڵ㣩 ===" << endl;
+    Tree<int> t;
+    buildCompleteTree(t, n);
+    IndexTree<int> it(t);
+
+    cout << "TreeNode<int>" << sizeof(TreeNode<int>) << " ֽ/ڵ㣬Լ "
+         << (double)sizeof(TreeNode<int>) * n / (1 << 20) << " MB" << endl;
+    cout << "IndexNode<int>" << sizeof(IndexNode<int>) << " ֽ/ڵ㣬Լ "
+         << (double)it.memoryUsage() / (1 << 20) << " MB" << endl;
+
+    SumVisitor s1, s2;
+    clock_t t0 = clock();
+    for (int r = 0; r < rounds; r++) t.inOrder(s1);
+    double treeTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    for (int r = 0; r < rounds; r++) it.inOrder(s2);
+    double indexTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    cout << "" << rounds << "֣Tree " << treeTime << " 룬IndexTree "
+         << indexTime << " 루" << (s1.sum == s2.sum ? "һ" : "һ") << "" << endl;
+}
+
+#endif  // INDEX_TREE_H
@@ -2,6 +2,11 @@
 #define TREE_H
 #include <iostream>
 #include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <new>
+#include <type_traits>
+#include "Arena.h"
 using namespace std;
 
 // ڵģ
@@ -11,12 +16,25 @@ struct TreeNode {
     TreeNode* left;   // ӽڵ
     TreeNode* right;  // ӽڵ
     TreeNode* parent; // ڵ
+    int size;         // ԸýڵΪģ
+    int height;       // ԸýڵΪ߶ȣҶڵΪ0
 
     // 캯
     TreeNode(const T& e = T(), TreeNode* l = NULL, TreeNode* r = NULL, TreeNode* p = NULL)
-        : data(e), left(l), right(r), parent(p) {}
+        : data(e), left(l), right(r), parent(p), size(1), height(0) {}
 };
 
+// ģ߶ȣģΪ0߶Ϊ-1
+template <typename T>
+inline int subtreeSize(const TreeNode<T>* p) {
+    return p ? p->size : 0;
+}
+
+template <typename T>
+inline int stature(const TreeNode<T>* p) {
+    return p ? p->height : -1;
+}
+
 // ӡԪصĺڱ
 template <typename T>
 void printElem(T& e) {
@@ -29,50 +47,96 @@ class Tree {
 protected:
     TreeNode<T>* _root;  // ڵ
     int _size;           // Ĺģڵ
+    Arena* _arena;       // ڵNULLʾʹnew/delete
+
+    // ½ڵ㣺ArenaʱArenaо͵ع죬ʹnew
+    TreeNode<T>* newNode(const T& e, TreeNode<T>* parent) {
+        if (_arena == NULL) return new TreeNode<T>(e, NULL, NULL, parent);
+        void* mem = _arena->allocate(sizeof(TreeNode<T>), alignof(TreeNode<T>));
+        return new (mem) TreeNode<T>(e, NULL, NULL, parent);
+    }
+
+    // ͷŵڵ㣺ArenaеĽڵֻռArenaͳһ
+    void freeNode(TreeNode<T>* p) {
+        if (_arena == NULL) delete p;
+        else p->~TreeNode<T>();
+    }
 
     // ݹɾpΪ
     void clear(TreeNode<T>* p) {
         if (p == NULL) return;
         clear(p->left);
         clear(p->right);
-        delete p;
+        freeNode(p);
         _size--;
     }
 
+    // ٣ArenaеĽڵֱӶO(1)
+    void destroyAll() {
+        if (_arena != NULL && is_trivially_destructible<T>::value) {
+            _root = NULL;
+            _size = 0;
+        } else {
+            clear(_root);
+            _root = NULL;
+        }
+    }
+
     // ݹ鸴pΪ¸ڵ
     TreeNode<T>* copy(TreeNode<T>* p, TreeNode<T>* parent) {
         if (p == NULL) return NULL;
-        TreeNode<T>* newNode = new TreeNode<T>(p->data, NULL, NULL, parent);
-        newNode->left = copy(p->left, newNode);
-        newNode->right = copy(p->right, newNode);
-        return newNode;
+        TreeNode<T>* node = newNode(p->data, parent);
+        node->left = copy(p->left, node);
+        node->right = copy(p->right, node);
+        node->size = p->size;
+        node->height = p->height;
+        return node;
+    }
+
+    // ģ仯deltapϸ¸ȵĹģ߶ȣO(depth)
+    void updateAbove(TreeNode<T>* p, int delta) {
+        for (; p != NULL; p = p->parent) {
+            p->size += delta;
+            p->height = 1 + max(stature(p->left), stature(p->right));
+        }
     }
 
 public:
     // 캯ʼ
-    Tree() : _root(NULL), _size(0) {}
+    // arenaǿʱнڵ㶼arenaз䣻arenaø
+    Tree(Arena* arena = NULL) : _root(NULL), _size(0), _arena(arena) {}
 
     // ͷнڵ
     ~Tree() {
-        clear(_root);
+        destroyAll();
     }
 
-    // 캯
-    Tree(const Tree& t) : _size(0) {
+    // 캯ԭͬһArena
+    Tree(const Tree& t) : _size(0), _arena(t._arena) {
         _root = copy(t._root, NULL);
         _size = t._size;
     }
 
-    // ֵ
+    // ֵ½ڵڱԼArenaУ
     Tree& operator=(const Tree& t) {
         if (this != &t) {
-            clear(_root);
+            destroyAll();
             _root = copy(t._root, NULL);
             _size = t._size;
         }
         return *this;
     }
 
+    // ʹArenaʱArena::reset()һԻȫڵ
+    void clear() {
+        destroyAll();
+    }
+
+    // ȡڵ
+    Arena* arena() const {
+        return _arena;
+    }
+
     // ڵΪpӽڵ㣬½ڵ
     TreeNode<T>* insertLeft(TreeNode<T>* p, const T& e) {
         if (p == NULL) return NULL;
@@ -80,8 +144,9 @@ public:
             cerr << "Error: Left child already exists." << endl;
             return NULL;
         }
-        p->left = new TreeNode<T>(e, NULL, NULL, p);
+        p->left = newNode(e, p);
         _size++;
+        updateAbove(p, 1);
         return p->left;
     }
 
@@ -92,8 +157,9 @@ public:
             cerr << "Error: Right child already exists." << endl;
             return NULL;
         }
-        p->right = new TreeNode<T>(e, NULL, NULL, p);
+        p->right = newNode(e, p);
         _size++;
+        updateAbove(p, 1);
         return p->right;
     }
 
@@ -103,7 +169,7 @@ public:
             cerr << "Error: Root already exists." << endl;
             return NULL;
         }
-        _root = new TreeNode<T>(e);
+        _root = newNode(e, NULL);
         _size++;
         return _root;
     }
@@ -111,27 +177,70 @@ public:
     // ɾpΪرɾڵ
     int remove(TreeNode<T>* p) {
         if (p == NULL) return 0;
-        int count = 0;
+        int count = p->size;
         TreeNode<T>* parent = p->parent;
-        clear(p);
         if (parent != NULL) {
             if (parent->left == p) parent->left = NULL;
             else parent->right = NULL;
         } else {
             _root = NULL;
         }
-        count = _size;
-        _size = 0; // clearѸ_size˴Ϊ
+        clear(p);  // clear_size
+        updateAbove(parent, -count);
         return count;
     }
 
+    // ΪkĽڵ㣨k0ʼģУO(h)
+    TreeNode<T>* kth(int k) const {
+        TreeNode<T>* p = _root;
+        while (p != NULL) {
+            int ls = subtreeSize(p->left);
+            if (k < ls) p = p->left;
+            else if (k == ls) return p;
+            else {
+                k -= ls + 1;
+                p = p->right;
+            }
+        }
+        return NULL;  // kԽ
+    }
+
+    // ڵpе0ʼظУO(h)
+    int rank(TreeNode<T>* p) const {
+        int r = subtreeSize(p->left);
+        for (; p->parent != NULL; p = p->parent) {
+            if (p->parent->right == p) r += subtreeSize(p->parent->left) + 1;
+        }
+        return r;
+    }
+
+    // ĶСeԪظO(h)
+    int rankOf(const T& e) const {
+        int r = 0;
+        TreeNode<T>* p = _root;
+        while (p != NULL) {
+            if (p->data < e) {
+                r += subtreeSize(p->left) + 1;
+                p = p->right;
+            } else {
+                p = p->left;
+            }
+        }
+        return r;
+    }
+
     // ԪeӽڵpʼĬϴӸڵ㿪ʼ
     TreeNode<T>* find(const T& e, TreeNode<T>* p = NULL) const {
         if (p == NULL) p = _root;
+        return findIn(e, p);
+    }
+
+    // pΪаǰepΪʱؿգٻصڵ㣩
+    TreeNode<T>* findIn(const T& e, TreeNode<T>* p) const {
         if (p == NULL || p->data == e) return p;
-        TreeNode<T>* left = find(e, p->left);
+        TreeNode<T>* left = findIn(e, p->left);
         if (left != NULL) return left;
-        return find(e, p->right);
+        return findIn(e, p->right);
     }
 
     // ǰ--
@@ -146,6 +255,20 @@ public:
         preOrder(_root, visit);
     }
 
+    // ͨʣЯ״̬ͣ
+    template <typename VST>
+    void preOrder(TreeNode<T>* p, VST& visit) const {
+        if (p == NULL) return;
+        visit(p->data);
+        preOrder(p->left, visit);
+        preOrder(p->right, visit);
+    }
+
+    template <typename VST>
+    void preOrder(VST& visit) const {
+        preOrder(_root, visit);
+    }
+
     // --
     void inOrder(TreeNode<T>* p, void (*visit)(T&)) const {
         if (p == NULL) return;
@@ -158,6 +281,19 @@ public:
         inOrder(_root, visit);
     }
 
+    template <typename VST>
+    void inOrder(TreeNode<T>* p, VST& visit) const {
+        if (p == NULL) return;
+        inOrder(p->left, visit);
+        visit(p->data);
+        inOrder(p->right, visit);
+    }
+
+    template <typename VST>
+    void inOrder(VST& visit) const {
+        inOrder(_root, visit);
+    }
+
     // --
     void postOrder(TreeNode<T>* p, void (*visit)(T&)) const {
         if (p == NULL) return;
@@ -170,11 +306,29 @@ public:
         postOrder(_root, visit);
     }
 
+    template <typename VST>
+    void postOrder(TreeNode<T>* p, VST& visit) const {
+        if (p == NULL) return;
+        postOrder(p->left, visit);
+        postOrder(p->right, visit);
+        visit(p->data);
+    }
+
+    template <typename VST>
+    void postOrder(VST& visit) const {
+        postOrder(_root, visit);
+    }
+
     // ȡĹģ
     int size() const {
         return _size;
     }
 
+    // ȡĸ߶ȣΪ-1O(1)
+    int height() const {
+        return stature(_root);
+    }
+
     // жǷΪ
     bool empty() const {
         return _size == 0;
@@ -194,7 +348,7 @@ public:
 };
 
 // ģĺѡɵmain.cppУ
-void testTree() {
+inline void testTree() {
     // Ի
     Tree<int> t;
     cout << "===  ===" << endl;
@@ -249,4 +403,46 @@ void testTree() {
     t.print();
 }
 
+// ĸΪÿڵҺӣֱģﵽn
+template <typename T>
+inline void buildCompleteTree(Tree<T>& t, int n) {
+    TreeNode<T>** level = new TreeNode<T>*[n];
+    int head = 0, tail = 0;
+    level[tail++] = t.insertRoot(T());
+    while (t.size() < n) {
+        TreeNode<T>* p = level[head++];
+        level[tail++] = t.insertLeft(p, T());
+        if (t.size() < n) level[tail++] = t.insertRight(p, T());
+    }
+    delete[] level;
+}
+
+// ܲԣnew/delete  Arena ַʽٰڵ
+inline void benchTreeArena(int n = 1000000, int rounds = 5) {
+    cout << "=== Arena䣨" << n << "ڵ㣬" << rounds << "֣ ===" << endl;
+
+    clock_t t0 = clock();
+    for (int r = 0; r < rounds; r++) {
+        Tree<int> t;
+        buildCompleteTree(t, n);
+    }  // ʱdelete
+    double heapTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    Arena arena;
+    double buildTime = 0, destroyTime = 0;
+    for (int r = 0; r < rounds; r++) {
+        clock_t b = clock();
+        Tree<int>* t = new Tree<int>(&arena);
+        buildCompleteTree(*t, n);
+        clock_t d = clock();
+        delete t;       // ڵO(1)
+        arena.reset();  // һԻ
+        buildTime += (double)(d - b) / CLOCKS_PER_SEC;
+        destroyTime += (double)(clock() - d) / CLOCKS_PER_SEC;
+    }
+
+    cout << "new/delete+ٹ " << heapTime << " " << endl;
+    cout << "Arena " << buildTime << " 룬 " << destroyTime << " " << endl;
+}
+
 #endif  // TREE_H
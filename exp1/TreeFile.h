@@ -0,0 +1,407 @@
+#ifndef TREE_FILE_H
+#define TREE_FILE_H
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <ctime>
+#include <vector>
+#include <type_traits>
+#include "IndexTree.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+using namespace std;
+
+// ƽļʽСˣֽ򣩣
+//   TreeFileHeader
+//   FlatLink  links[count]    ǰŵ飬ڱΪi+1
+//   T         data[count]     dataOffsetʼ16ֽڶ
+// ֻֿ֧ɰλƵͣintdoublepair<char,int>ȣ
+struct TreeFileHeader {
+    char magic[4];                  // "TREE"
+    unsigned int version;           // ʽ汾
+    unsigned int count;             // ڵ
+    unsigned int elemSize;          // sizeof(T)ʱУ
+    unsigned long long dataOffset;  // ļеƫ
+};
+
+// ļÿڵӣ32λ±
+struct FlatLink {
+    NodeIdx left;
+    NodeIdx right;
+    NodeIdx parent;
+};
+
+// Treeǰƽдļɹtrue
+template <typename T>
+bool saveTree(const Tree<T>& t, const char* file) {
+    static_assert(is_trivially_copyable<T>::value, "saveTree requires a trivially copyable T");
+    vector<FlatLink> links;
+    vector<T> data;
+    links.reserve(t.size());
+    data.reserve(t.size());
+
+    // ǰջм¼(ڵ, ڵ)ʱڵ
+    vector<pair<TreeNode<T>*, NodeIdx> > stk;
+    if (t.root() != NULL) stk.push_back(make_pair(t.root(), NIL));
+    while (!stk.empty()) {
+        TreeNode<T>* p = stk.back().first;
+        NodeIdx parent = stk.back().second;
+        stk.pop_back();
+        NodeIdx i = (NodeIdx)links.size();
+        FlatLink link = { NIL, NIL, parent };
+        links.push_back(link);
+        data.push_back(p->data);
+        if (parent != NIL) {
+            if (p->parent->left == p) links[parent].left = i;
+            else links[parent].right = i;
+        }
+        if (p->right != NULL) stk.push_back(make_pair(p->right, i));
+        if (p->left != NULL) stk.push_back(make_pair(p->left, i));
+    }
+
+    TreeFileHeader h;
+    memcpy(h.magic, "TREE", 4);
+    h.version = 1;
+    h.count = (unsigned int)links.size();
+    h.elemSize = sizeof(T);
+    unsigned long long linkEnd = sizeof(h) + (unsigned long long)h.count * sizeof(FlatLink);
+    h.dataOffset = (linkEnd + 15) & ~15ULL;
+
+    FILE* fp = fopen(file, "wb");
+    if (fp == NULL) return false;
+    static const char zeros[16] = { 0 };
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+    if (ok && h.count > 0) ok = fwrite(&links[0], sizeof(FlatLink), h.count, fp) == h.count;
+    if (ok && h.dataOffset > linkEnd) ok = fwrite(zeros, 1, h.dataOffset - linkEnd, fp) == h.dataOffset - linkEnd;
+    if (ok && h.count > 0) ok = fwrite(&data[0], sizeof(T), h.count, fp) == h.count;
+    fclose(fp);
+    return ok;
+}
+
+// ڴӳֱֻӳļϱκνڵ
+// ֻһmmap״ηʱȱҳʱֻУļͷO(1)
+// ڱ;飻ҪУ飨left/right/parentеʱverify()
+template <typename T>
+class MappedTree {
+private:
+    const char* _base;       // ӳʼַ
+    size_t _length;          // ӳ䳤
+    const FlatLink* _links;  // 
+    const T* _data;          // 
+    int _size;               // ڵ
+#ifdef _WIN32
+    HANDLE _file, _mapping;
+#else
+    int _fd;
+#endif
+
+    // ֹ
+    MappedTree(const MappedTree&);
+    MappedTree& operator=(const MappedTree&);
+
+    // еĶԼ飺icӺϷcǰλi֮󡢲Խ磬cĸָi
+    bool down(NodeIdx i, NodeIdx c) const {
+        return c > i && c < (NodeIdx)_size && _links[c].parent == i;
+    }
+
+    // еĶԼ飺iڵpӺϷpi֮ǰpǡһi
+    // Ӷһ¡±غӷϸ˱ԽҲɻ
+    bool up(NodeIdx i, NodeIdx p) const {
+        return p < i && ((_links[p].left == i) != (_links[p].right == i));
+    }
+
+    bool corrupt() const {
+        cerr << "Error: Corrupt links in tree file." << endl;
+        return false;
+    }
+
+    // iߵףӷǷʱfalse
+    bool leftmost(NodeIdx& i) const {
+        while (_links[i].left != NIL) {
+            if (!down(i, _links[i].left)) return false;
+            i = _links[i].left;
+        }
+        return true;
+    }
+
+    // iΪУĵһڵ㣻ӷǷʱNIL
+    NodeIdx firstPost(NodeIdx i) const {
+        while (true) {
+            NodeIdx c = _links[i].left != NIL ? _links[i].left : _links[i].right;
+            if (c == NIL) return i;
+            if (!down(i, c)) return NIL;
+            i = c;
+        }
+    }
+
+    // ӳļֻͼʧܷfalse
+    bool map(const char* file) {
+#ifdef _WIN32
+        _file = CreateFileA(file, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        if (_file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER sz;
+        if (!GetFileSizeEx(_file, &sz) || sz.QuadPart == 0) return false;
+        _length = (size_t)sz.QuadPart;
+        _mapping = CreateFileMappingA(_file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (_mapping == NULL) return false;
+        _base = (const char*)MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0);
+        return _base != NULL;
+#else
+        _fd = ::open(file, O_RDONLY);
+        if (_fd < 0) return false;
+        struct stat st;
+        if (fstat(_fd, &st) != 0 || st.st_size == 0) return false;
+        _length = (size_t)st.st_size;
+        void* p = mmap(NULL, _length, PROT_READ, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED) return false;
+        _base = (const char*)p;
+        return true;
+#endif
+    }
+
+public:
+    // 캯δκļ
+    MappedTree() : _base(NULL), _length(0), _links(NULL), _data(NULL), _size(0) {
+#ifdef _WIN32
+        _file = INVALID_HANDLE_VALUE;
+        _mapping = NULL;
+#else
+        _fd = -1;
+#endif
+    }
+
+    // ӳ
+    ~MappedTree() {
+        close();
+    }
+
+    // 򿪲Уļɹtrue
+    bool open(const char* file) {
+        static_assert(is_trivially_copyable<T>::value, "MappedTree requires a trivially copyable T");
+        close();
+        if (!map(file) || _length < sizeof(TreeFileHeader)) {
+            close();
+            return false;
+        }
+        const TreeFileHeader* h = (const TreeFileHeader*)_base;
+        // ļȱȽӣcountdataOffsetܴʱ
+        unsigned long long len = _length, count = h->count;
+        unsigned long long linkEnd = sizeof(TreeFileHeader) + count * sizeof(FlatLink);
+        if (memcmp(h->magic, "TREE", 4) != 0 || h->version != 1 || h->elemSize != sizeof(T) ||
+            count > 0x7FFFFFFFULL || count > len / sizeof(FlatLink) || h->dataOffset < linkEnd ||
+            h->dataOffset > len || count > (len - h->dataOffset) / sizeof(T) || h->dataOffset % alignof(T) != 0) {
+            cerr << "Error: Invalid tree file." << endl;
+            close();
+            return false;
+        }
+        _size = (int)h->count;
+        _links = (const FlatLink*)(_base + sizeof(TreeFileHeader));
+        _data = (const T*)(_base + h->dataOffset);
+        return true;
+    }
+
+    // УǷһúϷǰŵĶΪi+1Һi֮
+    // ڵi֮ǰ뺢ӵӻһ¡ȫӣO(n)˲openʱԶ
+    bool verify() const {
+        NodeIdx n = (NodeIdx)_size;
+        for (NodeIdx i = 0; i < n; i++) {
+            const FlatLink& l = _links[i];
+            if (i == 0 && l.parent != NIL) return false;
+            if (i > 0 && (l.parent >= i || (_links[l.parent].left != i && _links[l.parent].right != i))) return false;
+            if (l.left != NIL && (l.left != i + 1 || l.left >= n || _links[l.left].parent != i)) return false;
+            if (l.right != NIL && (l.right <= i || l.right >= n || _links[l.right].parent != i)) return false;
+        }
+        return true;
+    }
+
+    // ӳ䲢رļ
+    void close() {
+#ifdef _WIN32
+        if (_base != NULL) UnmapViewOfFile(_base);
+        if (_mapping != NULL) CloseHandle(_mapping);
+        if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+        _file = INVALID_HANDLE_VALUE;
+        _mapping = NULL;
+#else
+        if (_base != NULL) munmap((void*)_base, _length);
+        if (_fd >= 0) ::close(_fd);
+        _fd = -1;
+#endif
+        _base = NULL;
+        _length = 0;
+        _links = NULL;
+        _data = NULL;
+        _size = 0;
+    }
+
+    // ڵʽӿڣڵǰűʶΪ0ļеԭʼӣ
+    NodeIdx root() const { return _size > 0 ? 0 : NIL; }
+    NodeIdx left(NodeIdx i) const { return _links[i].left; }
+    NodeIdx right(NodeIdx i) const { return _links[i].right; }
+    NodeIdx parent(NodeIdx i) const { return _links[i].parent; }
+    const T& data(NodeIdx i) const { return _data[i]; }
+
+    // ȡĹģ
+    int size() const {
+        return _size;
+    }
+
+    // жǷΪ
+    bool empty() const {
+        return _size == 0;
+    }
+
+    // ԪeǰһƥĽڵ㣺ǰż˳˳ɨ輴
+    NodeIdx find(const T& e) const {
+        for (int i = 0; i < _size; i++) {
+            if (_data[i] == e) return (NodeIdx)i;
+        }
+        return NIL;
+    }
+
+    // visitΪ
+    // ǰ鱾ǰ
+    template <typename VST>
+    void preOrder(VST& visit) const {
+        for (int i = 0; i < _size; i++) visit(_data[i]);
+    }
+
+    // ӵǷʱֹͣfalse֮ǰĽڵѱʣ
+    template <typename VST>
+    bool inOrder(VST& visit) const {
+        if (_size == 0) return true;
+        NodeIdx i = 0;
+        if (!leftmost(i)) return corrupt();
+        while (i != NIL) {
+            visit(_data[i]);
+            NodeIdx r = _links[i].right;
+            if (r != NIL) {
+                if (!down(i, r)) return corrupt();
+                i = r;
+                if (!leftmost(i)) return corrupt();
+                continue;
+            }
+            // ݵһصȣӸ
+            while (true) {
+                if (i == 0) return true;
+                NodeIdx p = _links[i].parent;
+                if (!up(i, p)) return corrupt();
+                bool fromLeft = (_links[p].left == i);
+                i = p;
+                if (fromLeft) break;
+            }
+        }
+        return true;
+    }
+
+    // ӵǷʱֹͣfalse֮ǰĽڵѱʣ
+    template <typename VST>
+    bool postOrder(VST& visit) const {
+        if (_size == 0) return true;
+        NodeIdx i = firstPost(0);
+        while (i != NIL) {
+            visit(_data[i]);
+            if (i == 0) return true;
+            NodeIdx q = _links[i].parent;
+            if (!up(i, q)) break;
+            if (_links[q].left == i && _links[q].right != NIL) {
+                if (!down(q, _links[q].right)) break;
+                i = firstPost(_links[q].right);
+            } else {
+                i = q;
+            }
+        }
+        return corrupt();
+    }
+};
+
+// ܲԣڵؽTree  ӳļֱӱ 
+inline void benchTreeFile(const char* file = "tree.bin", int n = 1000000) {
+    cout << "=== ıƽ洢" << n << "ڵ㣩 ===" << endl;
+    Tree<int> t;
+    buildCompleteTree(t, n);
+
+    clock_t t0 = clock();
+    if (!saveTree(t, file)) {
+        cerr << "Error: Cannot write " << file << endl;
+        return;
+    }
+    double saveTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    Tree<int> rebuilt(t);  // գڵ㸴ؽ
+    double copyTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    MappedTree<int> mt;
+    mt.open(file);
+    double openTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    SumVisitor sum;
+    mt.postOrder(sum);
+    double walkTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    cout << "дļ " << saveTime << " 룬ڵؽ " << copyTime << " " << endl;
+    cout << "ӳ " << openTime << " 룬״κ " << walkTime << " 루ڵ "
+         << mt.size() << "" << endl;
+    mt.close();
+    remove(file);
+}
+
+// ļеiڵĳֶθΪv
+inline bool patchTreeLink(const char* file, NodeIdx i, size_t field, NodeIdx v) {
+    FILE* fp = fopen(file, "r+b");
+    if (fp == NULL) return false;
+    fseek(fp, (long)(sizeof(TreeFileHeader) + i * sizeof(FlatLink) + field), SEEK_SET);
+    bool ok = fwrite(&v, sizeof(v), 1, fp) == 1;
+    fclose(fp);
+    return ok;
+}
+
+// ȷԲԣõļͨУ𻵵Ҫôverify()֣
+// ҪôʹfalseԽѭ
+inline bool testTreeFile(const char* file = "tree_test.bin") {
+    cout << "=== ļУ ===" << endl;
+    const int n = 100;
+    Tree<int> t;
+    buildCompleteTree(t, n);
+    MappedTree<int> mt;
+    SumVisitor sum;
+    bool ok = saveTree(t, file) && mt.open(file) && mt.verify() && mt.inOrder(sum) && mt.postOrder(sum);
+    mt.close();
+
+    // 𻵣Խ±ꡢָǰĽڵ㣨ɻӲһ¡Һͬ
+    struct Patch { NodeIdx node; size_t field; NodeIdx value; };
+    const Patch patches[] = {
+        { 0, offsetof(FlatLink, left), (NodeIdx)n + 5 },
+        { 1, offsetof(FlatLink, right), 0 },
+        { 5, offsetof(FlatLink, parent), 7 },
+        { 3, offsetof(FlatLink, right), 4 },
+        { (NodeIdx)n - 1, offsetof(FlatLink, parent), NIL },
+    };
+    int caught = 0, total = sizeof(patches) / sizeof(patches[0]);
+    for (int k = 0; k < total; k++) {
+        if (!saveTree(t, file) || !patchTreeLink(file, patches[k].node, patches[k].field, patches[k].value)) {
+            ok = false;
+            break;
+        }
+        if (!mt.open(file)) continue;  // ļͷãӦܴ
+        bool walked = mt.inOrder(sum) && mt.postOrder(sum);
+        if (!mt.verify() && !walked) caught++;
+        mt.close();
+    }
+    ok = ok && caught == total;
+    cout << "𻵵ӣ" << caught << "/" << total << " ֣" << (ok ? "ȷ" : "") << "" << endl;
+    remove(file);
+    return ok;
+}
+
+#endif  // TREE_FILE_H
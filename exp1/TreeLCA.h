@@ -0,0 +1,296 @@
+#ifndef TREE_LCA_H
+#define TREE_LCA_H
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <ctime>
+#include "Tree.h"
+using namespace std;
+
+// ̬ıڵ㰴ǰΪ0..n-1
+// ǰģO(1)жvuȵҽ v <= u < v + size(v)
+template <typename T>
+class TreeIndex {
+protected:
+    vector<TreeNode<T>*> _node;                    //  -> ڵ
+    vector<int> _parent;                           // ڵţΪ-1
+    vector<int> _depth;                            // ȣΪ0
+    vector<int> _size;                             // ģ
+    unordered_map<const TreeNode<T>*, int> _id;    // ڵ -> 
+
+    // ǰšӹϵ
+    void index(const Tree<T>& t) {
+        int n = t.size();
+        _node.clear();
+        _parent.clear();
+        _depth.clear();
+        _node.reserve(n);
+        _parent.reserve(n);
+        _depth.reserve(n);
+        _id.clear();
+        _id.reserve(n);
+        vector<pair<TreeNode<T>*, int> > stk;  // (ڵ, ڵ)
+        if (t.root() != NULL) stk.push_back(make_pair(t.root(), -1));
+        while (!stk.empty()) {
+            TreeNode<T>* p = stk.back().first;
+            int parent = stk.back().second;
+            stk.pop_back();
+            int i = (int)_node.size();
+            _node.push_back(p);
+            _parent.push_back(parent);
+            _depth.push_back(parent < 0 ? 0 : _depth[parent] + 1);
+            _id[p] = i;
+            if (p->right != NULL) stk.push_back(make_pair(p->right, i));
+            if (p->left != NULL) stk.push_back(make_pair(p->left, i));
+        }
+        // ǰۼģӽڵܴڸڵ㣩
+        _size.assign(_node.size(), 1);
+        for (int i = (int)_node.size() - 1; i > 0; i--) _size[_parent[i]] += _size[i];
+    }
+
+public:
+    // ڵ
+    int size() const {
+        return (int)_node.size();
+    }
+
+    // ڵ <-> ţڵ㲻ʱ-1
+    int id(const TreeNode<T>* p) const {
+        typename unordered_map<const TreeNode<T>*, int>::const_iterator it = _id.find(p);
+        return it == _id.end() ? -1 : it->second;
+    }
+
+    TreeNode<T>* node(int i) const {
+        return i < 0 ? NULL : _node[i];
+    }
+
+    // ڵ
+    int depth(int u) const {
+        return _depth[u];
+    }
+
+    // vǷΪuȣuO(1)
+    bool isAncestor(int v, int u) const {
+        return v <= u && u < v + _size[v];
+    }
+
+    bool isAncestor(const TreeNode<T>* v, const TreeNode<T>* u) const {
+        return isAncestor(id(v), id(u));
+    }
+};
+
+// ŷ + ϡRMQȣԤO(n log n)ѯO(1)
+template <typename T>
+class TreeLCA : public TreeIndex<T> {
+private:
+    vector<int> _first;          // ÿڵŷ״γֵλ
+    vector<vector<int> > _table; // _table[j][i]ŷ[i, i + 2^j)СĽڵ
+    vector<int> _log;            // _log[len] = floor(log2(len))
+
+    // ȽС
+    int shallower(int a, int b) const {
+        return this->_depth[a] <= this->_depth[b] ? a : b;
+    }
+
+public:
+    TreeLCA() {}
+    TreeLCA(const Tree<T>& t) { build(t); }
+
+    // Ԥŷ򲢽ϡ
+    void build(const Tree<T>& t) {
+        this->index(t);
+        int n = this->size();
+        _first.assign(n, 0);
+        _table.clear();
+        if (n == 0) return;
+
+        // ŷ򣺽ڵʱ¼һΣÿصڵʱټ¼һ
+        vector<int> euler;
+        euler.reserve(2 * n - 1);
+        vector<int> stk(1, 0);
+        vector<char> expanded(n, 0);
+        while (!stk.empty()) {
+            int u = stk.back();
+            if (!expanded[u]) {
+                expanded[u] = 1;
+                _first[u] = (int)euler.size();
+                euler.push_back(u);
+                // ӽڵѹջ֤ȷ
+                // ǰΪu+1Һӽ֮
+                TreeNode<T>* p = this->_node[u];
+                int ls = p->left != NULL ? this->_size[u + 1] : 0;
+                if (p->right != NULL) stk.push_back(u + 1 + ls);
+                if (p->left != NULL) stk.push_back(u + 1);
+            } else {
+                // ϣصڵ
+                stk.pop_back();
+                if (this->_parent[u] >= 0) euler.push_back(this->_parent[u]);
+            }
+        }
+
+        int m = (int)euler.size();
+        _log.assign(m + 1, 0);
+        for (int i = 2; i <= m; i++) _log[i] = _log[i / 2] + 1;
+        _table.assign(_log[m] + 1, vector<int>());
+        _table[0] = euler;
+        for (int j = 1; j <= _log[m]; j++) {
+            int len = m - (1 << j) + 1;
+            _table[j].resize(len);
+            for (int i = 0; i < len; i++) {
+                _table[j][i] = shallower(_table[j - 1][i], _table[j - 1][i + (1 << (j - 1))]);
+            }
+        }
+    }
+
+    // ȣʽO(1)
+    int lca(int u, int v) const {
+        int l = _first[u], r = _first[v];
+        if (l > r) swap(l, r);
+        int j = _log[r - l + 1];
+        return shallower(_table[j][l], _table[j][r - (1 << j) + 1]);
+    }
+
+    // ȣڵʽ
+    TreeNode<T>* lca(const TreeNode<T>* u, const TreeNode<T>* v) const {
+        return this->node(lca(this->id(u), this->id(v)));
+    }
+
+    // ѯout[i] = lca(queries[i])
+    void lca(const vector<pair<int, int> >& queries, vector<int>& out) const {
+        out.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) out[i] = lca(queries[i].first, queries[i].second);
+    }
+
+    // ڵľ루
+    int distance(int u, int v) const {
+        return this->_depth[u] + this->_depth[v] - 2 * this->_depth[lca(u, v)];
+    }
+};
+
+// ڱbinary liftingȲѯԤO(n log n)ѯO(log n)
+// ڴԼΪŷϡһ룬ֵ֧k
+template <typename T>
+class TreeLifting : public TreeIndex<T> {
+private:
+    vector<vector<int> > _up;  // _up[j][u]uĵ2^jȣΪ-1
+
+public:
+    TreeLifting() {}
+    TreeLifting(const Tree<T>& t) { build(t); }
+
+    // Ԥ𼶱ָ
+    void build(const Tree<T>& t) {
+        this->index(t);
+        int n = this->size();
+        int levels = 1;
+        while ((1 << levels) < n) levels++;
+        _up.assign(levels, vector<int>());
+        _up[0] = this->_parent;
+        for (int j = 1; j < levels; j++) {
+            _up[j].resize(n);
+            for (int u = 0; u < n; u++) {
+                int mid = _up[j - 1][u];
+                _up[j][u] = mid < 0 ? -1 : _up[j - 1][mid];
+            }
+        }
+    }
+
+    // uĵkȣk=0Ϊڷ-1O(log n)
+    int kthAncestor(int u, int k) const {
+        if (k > this->_depth[u]) return -1;
+        for (int j = 0; k > 0 && u >= 0; j++, k >>= 1) {
+            if (k & 1) u = _up[j][u];
+        }
+        return u;
+    }
+
+    TreeNode<T>* kthAncestor(const TreeNode<T>* u, int k) const {
+        return this->node(kthAncestor(this->id(u), k));
+    }
+
+    // ȣʽO(log n)
+    int lca(int u, int v) const {
+        if (this->isAncestor(u, v)) return u;
+        if (this->isAncestor(v, u)) return v;
+        // ԸλλԾuv
+        for (int j = (int)_up.size() - 1; j >= 0; j--) {
+            int w = _up[j][u];
+            if (w >= 0 && !this->isAncestor(w, v)) u = w;
+        }
+        return this->_parent[u];
+    }
+
+    TreeNode<T>* lca(const TreeNode<T>* u, const TreeNode<T>* v) const {
+        return this->node(lca(this->id(u), this->id(v)));
+    }
+
+    // ѯout[i] = lca(queries[i])
+    void lca(const vector<pair<int, int> >& queries, vector<int>& out) const {
+        out.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) out[i] = lca(queries[i].first, queries[i].second);
+    }
+
+    // kȣout[i] = kthAncestor(queries[i].first, queries[i].second)
+    void kthAncestor(const vector<pair<int, int> >& queries, vector<int>& out) const {
+        out.resize(queries.size());
+        for (size_t i = 0; i < queries.size(); i++) {
+            out[i] = kthAncestor(queries[i].first, queries[i].second);
+        }
+    }
+};
+
+// ظָȣã
+template <typename T>
+TreeNode<T>* naiveLCA(TreeNode<T>* u, TreeNode<T>* v) {
+    int du = 0, dv = 0;
+    for (TreeNode<T>* p = u; p->parent != NULL; p = p->parent) du++;
+    for (TreeNode<T>* p = v; p->parent != NULL; p = p->parent) dv++;
+    for (; du > dv; du--) u = u->parent;
+    for (; dv > du; dv--) v = v->parent;
+    while (u != v) {
+        u = u->parent;
+        v = v->parent;
+    }
+    return u;
+}
+
+// ܲԣLCAѯԱСŷRMQ뱶
+inline void benchTreeLCA(int n = 1000000, int queries = 1000000) {
+    cout << "=== LCAѯ" << n << "ڵ㣬" << queries << "βѯ ===" << endl;
+    Tree<int> t;
+    buildCompleteTree(t, n);
+
+    clock_t t0 = clock();
+    TreeLCA<int> euler(t);
+    double eulerBuild = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    TreeLifting<int> lifting(t);
+    double liftBuild = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    srand(12345);
+    vector<pair<int, int> > q(queries);
+    for (int i = 0; i < queries; i++) {
+        q[i] = make_pair((int)(((long long)rand() * RAND_MAX + rand()) % n),
+                         (int)(((long long)rand() * RAND_MAX + rand()) % n));
+    }
+    vector<int> a, b;
+    vector<TreeNode<int>*> c(queries);
+
+    t0 = clock();
+    for (int i = 0; i < queries; i++) c[i] = naiveLCA(euler.node(q[i].first), euler.node(q[i].second));
+    double naiveTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    euler.lca(q, a);
+    double eulerTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    lifting.lca(q, b);
+    double liftTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    cout << "ԤŷRMQ " << eulerBuild << " 룬 " << liftBuild << " " << endl;
+    bool same = (a == b);
+    for (int i = 0; same && i < queries; i++) same = (euler.node(a[i]) == c[i]);
+    cout << "ѯ " << naiveTime << " 룬ŷRMQ " << eulerTime
+         << " 룬 " << liftTime << " 루" << (same ? "һ" : "һ") << "" << endl;
+}
+
+#endif  // TREE_LCA_H
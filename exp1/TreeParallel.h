@@ -0,0 +1,289 @@
+#ifndef TREE_PARALLEL_H
+#define TREE_PARALLEL_H
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include "Tree.h"
+using namespace std;
+
+// ̹߳һ
+// ÿ߳ñջȱѴcutoffڵ߳̿ʱ
+// Űѱջײģ󣩵һָأ
+// СcutoffԶᱻ֣ƫбҲܾ⸺
+template <typename T>
+class TreeWalker {
+private:
+    mutex _mtx;
+    condition_variable _cv;
+    vector<TreeNode<T>*> _tasks;  // ĸ
+    atomic<int> _idle;            // ڵȴ߳
+    atomic<bool> _stop;           // ǰֹ־findУ
+    bool _done;                   // ȫ
+    int _threads;                 // ߳
+    int _cutoff;                  // ȣڵ
+
+    // ȡһ̶߳ʱ˵NULL
+    TreeNode<T>* take() {
+        unique_lock<mutex> lk(_mtx);
+        while (true) {
+            if (_done || _stop.load(memory_order_relaxed)) {
+                _done = true;
+                _cv.notify_all();
+                return NULL;
+            }
+            if (!_tasks.empty()) {
+                TreeNode<T>* p = _tasks.back();
+                _tasks.pop_back();
+                return p;
+            }
+            if (++_idle == _threads) {
+                _done = true;
+                _cv.notify_all();
+                return NULL;
+            }
+            _cv.wait(lk);
+            --_idle;
+        }
+    }
+
+    // ѱջײһ뽻
+    void donate(vector<TreeNode<T>*>& stk) {
+        size_t half = stk.size() / 2;
+        lock_guard<mutex> lk(_mtx);
+        _tasks.insert(_tasks.end(), stk.begin(), stk.begin() + half);
+        stk.erase(stk.begin(), stk.begin() + half);
+        _cv.notify_all();
+    }
+
+    // ߳ѭvisitfalseʱֹ
+    template <typename VST>
+    void work(VST& visit) {
+        vector<TreeNode<T>*> stk;
+        TreeNode<T>* root;
+        while ((root = take()) != NULL) {
+            stk.push_back(root);
+            int count = 0;
+            while (!stk.empty()) {
+                TreeNode<T>* p = stk.back();
+                stk.pop_back();
+                if (!visit(p)) {
+                    _stop.store(true);
+                    stk.clear();
+                    break;
+                }
+                if (p->right != NULL) stk.push_back(p->right);
+                if (p->left != NULL) stk.push_back(p->left);
+                if (++count >= _cutoff) {
+                    count = 0;
+                    if (_stop.load(memory_order_relaxed)) {
+                        stk.clear();
+                        break;
+                    }
+                    if (_idle.load(memory_order_relaxed) > 0 && stk.size() > 1) donate(stk);
+                }
+            }
+        }
+    }
+
+public:
+    // threadsΪ0ʱʹӲ߳
+    TreeWalker(int threads = 0, int cutoff = 1024)
+        : _idle(0), _stop(false), _done(false), _threads(threads), _cutoff(cutoff) {
+        if (_threads <= 0) _threads = (int)thread::hardware_concurrency();
+        if (_threads <= 0) _threads = 1;
+        if (_cutoff <= 0) _cutoff = 1;
+    }
+
+    // rootΪvisits[i]Ϊi̵߳ķbool operator()(TreeNode<T>*)
+    template <typename VST>
+    void run(TreeNode<T>* root, vector<VST>& visits) {
+        if (root == NULL) return;
+        _tasks.assign(1, root);
+        _idle = 0;
+        _stop = false;
+        _done = false;
+        vector<thread> pool;
+        for (int i = 1; i < _threads; i++) {
+            pool.push_back(thread(&TreeWalker::work<VST>, this, ref(visits[i])));
+        }
+        work(visits[0]);  // ǰ߳Ҳ
+        for (size_t i = 0; i < pool.size(); i++) pool[i].join();
+    }
+
+    // ߳
+    int threads() const {
+        return _threads;
+    }
+
+    // һαǷǰֹ
+    bool stopped() const {
+        return _stop.load();
+    }
+};
+
+// Լÿ̰߳mapĽۻԼľֲֵ
+template <typename T, typename R, typename Map, typename Combine>
+struct ReduceVisitor {
+    R value;
+    Map map;
+    Combine combine;
+
+    ReduceVisitor(const R& identity, Map m, Combine c) : value(identity), map(m), combine(c) {}
+    bool operator()(TreeNode<T>* p) {
+        value = combine(value, map(p->data));
+        return true;
+    }
+};
+
+// йԼÿڵmap(data)combineϲcombine뽻ɣ
+template <typename T, typename R, typename Map, typename Combine>
+R parallelReduce(const Tree<T>& t, const R& identity, Map map, Combine combine,
+                 int threads = 0, int cutoff = 1024) {
+    TreeWalker<T> walker(threads, cutoff);
+    vector<ReduceVisitor<T, R, Map, Combine> > visits(
+        walker.threads(), ReduceVisitor<T, R, Map, Combine>(identity, map, combine));
+    walker.run(t.root(), visits);
+    R result = identity;
+    for (size_t i = 0; i < visits.size(); i++) result = combine(result, visits[i].value);
+    return result;
+}
+
+// ÿڵvisit(data)
+template <typename T, typename VST>
+struct ForEachVisitor {
+    VST visit;
+
+    ForEachVisitor(VST v) : visit(v) {}
+    bool operator()(TreeNode<T>* p) {
+        visit(p->data);
+        return true;
+    }
+};
+
+// бÿڵvisit(data)ʴȷvisit̰߳ȫ
+template <typename T, typename VST>
+void parallelForEach(const Tree<T>& t, VST visit, int threads = 0, int cutoff = 1024) {
+    TreeWalker<T> walker(threads, cutoff);
+    vector<ForEachVisitor<T, VST> > visits(walker.threads(), ForEachVisitor<T, VST>(visit));
+    walker.run(t.root(), visits);
+}
+
+// ӳ䣺νʼ10
+template <typename T, typename Pred>
+struct CountMap {
+    Pred pred;
+
+    CountMap(Pred p) : pred(p) {}
+    long long operator()(const T& e) const {
+        return pred(e) ? 1 : 0;
+    }
+};
+
+// ӷϲ
+template <typename R>
+struct SumCombine {
+    R operator()(const R& a, const R& b) const {
+        return a + b;
+    }
+};
+
+// мͳpredĽڵ
+template <typename T, typename Pred>
+long long parallelCount(const Tree<T>& t, Pred pred, int threads = 0, int cutoff = 1024) {
+    return parallelReduce(t, 0LL, CountMap<T, Pred>(pred), SumCombine<long long>(), threads, cutoff);
+}
+
+// ҷк¼ڵ㲢falseȫ߳ǰֹ
+template <typename T>
+struct FindVisitor {
+    const T* target;
+    TreeNode<T>* hit;
+
+    FindVisitor(const T& e) : target(&e), hit(NULL) {}
+    bool operator()(TreeNode<T>* p) {
+        if (p->data == *target) {
+            hit = p;
+            return false;
+        }
+        return true;
+    }
+};
+
+// вңһݵeĽڵ㣨֤ǰһҲNULL
+template <typename T>
+TreeNode<T>* parallelFind(const Tree<T>& t, const T& e, int threads = 0, int cutoff = 1024) {
+    TreeWalker<T> walker(threads, cutoff);
+    vector<FindVisitor<T> > visits(walker.threads(), FindVisitor<T>(e));
+    walker.run(t.root(), visits);
+    for (size_t i = 0; i < visits.size(); i++) {
+        if (visits[i].hit != NULL) return visits[i].hit;
+    }
+    return NULL;
+}
+
+// ƫбĸÿڵʣڵ㰴ratio : (1-ratio)ָ
+template <typename T>
+void buildSkewedTree(Tree<T>& t, TreeNode<T>* p, int n, double ratio, T& next) {
+    int rest = n - 1;
+    int nl = (int)(rest * ratio);
+    int nr = rest - nl;
+    if (nl > 0) buildSkewedTree(t, t.insertLeft(p, next++), nl, ratio, next);
+    if (nr > 0) buildSkewedTree(t, t.insertRight(p, next++), nr, ratio, next);
+}
+
+// ȡֵӳżνʣܲʹã
+struct IdentityMap {
+    long long operator()(const int& e) const { return e; }
+};
+struct IsEven {
+    bool operator()(const int& e) const { return e % 2 == 0; }
+};
+
+// ˳Ϊڵα
+struct NumberNode {
+    int next;
+    NumberNode() : next(0) {}
+    void operator()(int& e) { e = next++; }
+};
+
+// ܲԣƽƫбϵĲ͡
+inline void benchParallelTree(int n = 4000000) {
+    typedef chrono::steady_clock Clock;
+    Tree<int> balanced;
+    buildCompleteTree(balanced, n);
+    NumberNode number;
+    balanced.preOrder(number);  // ǰΪڵ
+    int next = 0;
+    Tree<int> skewed;
+    buildSkewedTree(skewed, skewed.insertRoot(next++), n, 0.9, next);
+
+    const char* names[] = { "ƽ", "ƫб(9:1)" };
+    Tree<int>* trees[] = { &balanced, &skewed };
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads <= 0) maxThreads = 1;
+
+    cout << "=== Բ" << n << "ڵ㣩 ===" << endl;
+    for (int k = 0; k < 2; k++) {
+        for (int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+            Clock::time_point t0 = Clock::now();
+            long long sum = parallelReduce(*trees[k], 0LL, IdentityMap(), SumCombine<long long>(), threads);
+            Clock::time_point t1 = Clock::now();
+            long long even = parallelCount(*trees[k], IsEven(), threads);
+            Clock::time_point t2 = Clock::now();
+            TreeNode<int>* hit = parallelFind(*trees[k], n / 2, threads);
+            Clock::time_point t3 = Clock::now();
+            cout << names[k] << " ߳ " << threads
+                 << " " << chrono::duration<double>(t1 - t0).count() << " 루" << sum << ""
+                 << " " << chrono::duration<double>(t2 - t1).count() << " 루" << even << ""
+                 << " " << chrono::duration<double>(t3 - t2).count() << " 루"
+                 << (hit ? "" : "δ") << "" << endl;
+            if (threads == maxThreads) break;
+        }
+    }
+}
+
+#endif  // TREE_PARALLEL_H
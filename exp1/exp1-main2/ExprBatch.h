@@ -0,0 +1,88 @@
+#ifndef EXPR_BATCH_H
+#define EXPR_BATCH_H
+#include <cmath>
+#include <vector>
+#include "Expression.h"
+using namespace std;
+
+// ֵѱõıʽڶ
+// ÿδBLOCKУÿִָһѭڱԶ
+// ָɵĿ̯еExprProgram::evalȫһ£
+// 㡢׳˵ЧֵΪNaNıõNaNNaNغ㴫ݣx^0
+class ExprBatch {
+public:
+    enum { BLOCK = 256 };  // ÿĴL1
+
+private:
+    const ExprProgram& _prog;
+    vector<double> _regs;          // ֵջÿһBLOCKdouble
+    vector<const double*> _slot;   // 㵱ǰݵλãֱָУ⿽
+
+    // ˫Ŀ㣺d = a op bԪ
+    static void binary(int op, const double* a, const double* b, double* d, int n) {
+        switch (op) {
+            case ADD: for (int i = 0; i < n; i++) d[i] = a[i] + b[i]; break;
+            case SUB: for (int i = 0; i < n; i++) d[i] = a[i] - b[i]; break;
+            case MUL: for (int i = 0; i < n; i++) d[i] = a[i] * b[i]; break;
+            case DIV:  // calculateһ£NaN
+                for (int i = 0; i < n; i++) d[i] = (b[i] == 0) ? NAN : a[i] / b[i];
+                break;
+            case POW:  // pow(NaN, 0) == 1ʽNaN
+                for (int i = 0; i < n; i++) {
+                    d[i] = (isnan(a[i]) || isnan(b[i])) ? NAN : pow(a[i], b[i]);
+                }
+                break;
+        }
+    }
+
+    // һݣӵbasenУִ򣬽дout
+    void runBlock(const double* const* columns, int base, int n, double* out) {
+        int top = 0;
+        for (int k = 0; k < _prog.length(); k++) {
+            const Instr& in = _prog.instr(k);
+            if (in.op == PUSH_NUM) {
+                double c = _prog.constant(in.arg);
+                double* d = &_regs[top * BLOCK];
+                for (int i = 0; i < n; i++) d[i] = c;
+                _slot[top++] = d;
+            } else if (in.op == PUSH_VAR) {
+                _slot[top++] = columns[in.arg] + base;
+            } else if (in.op == FAC) {
+                const double* a = _slot[top - 1];
+                double* d = &_regs[(top - 1) * BLOCK];
+                for (int i = 0; i < n; i++) d[i] = factorial(a[i]);
+                _slot[top - 1] = d;
+            } else {
+                top--;
+                const double* a = _slot[top - 1];
+                const double* b = _slot[top];
+                double* d = &_regs[(top - 1) * BLOCK];
+                binary(in.op, a, b, d, n);
+                _slot[top - 1] = d;
+            }
+        }
+        const double* r = _slot[0];
+        for (int i = 0; i < n; i++) out[i] = r[i];
+    }
+
+public:
+    ExprBatch(const ExprProgram& prog) : _prog(prog) {
+        int depth = prog.stackDepth();
+        _regs.resize((size_t)depth * BLOCK);
+        _slot.resize(depth);
+    }
+
+    // ֵcolumns[v]ΪvExprProgram::varNameţrowsֵдout
+    void eval(const double* const* columns, int rows, double* out) {
+        if (!_prog.valid()) {
+            for (int i = 0; i < rows; i++) out[i] = NAN;
+            return;
+        }
+        for (int base = 0; base < rows; base += BLOCK) {
+            int n = (rows - base < BLOCK) ? rows - base : BLOCK;
+            runBlock(columns, base, n, out + base);
+        }
+    }
+};
+
+#endif  // EXPR_BATCH_H
@@ -0,0 +1,76 @@
+#ifndef EXPR_CACHE_H
+#define EXPR_CACHE_H
+#include <cctype>
+#include <string>
+#include <list>
+#include <unordered_map>
+#include "Expression.h"
+using namespace std;
+
+// ʽ棨LRUԹ淶ıʽıΪʱֱӷϴεĽ
+// 淶ֻȥհַExprProgramԿհ׵Ĺһ£ıʽֵΪNaN
+class ExprCache {
+private:
+    typedef pair<string, double> Entry;                  // (淶ı, )
+    list<Entry> _lru;                                    // ͷΪʹ
+    unordered_map<string, list<Entry>::iterator> _index; // ı -> λ
+    size_t _capacity;                                    // ໺Ŀ
+    long long _hits, _misses;                            // δд
+    ExprProgram _prog;                                   // δʱõı
+    string _key;                                         // õļ
+
+    // ȥհַ
+    void normalize(const char* expr) {
+        _key.clear();
+        for (const char* s = expr; *s != '\0'; s++) {
+            if (!isspace((unsigned char)*s)) _key.push_back(*s);
+        }
+    }
+
+public:
+    ExprCache(size_t capacity = 4096) : _capacity(capacity > 0 ? capacity : 1), _hits(0), _misses(0) {}
+
+    // ֵO(1)ػ루۵ֵ뻺
+    double eval(const char* expr) {
+        if (expr == NULL) return NAN;
+        normalize(expr);
+        unordered_map<string, list<Entry>::iterator>::iterator it = _index.find(_key);
+        if (it != _index.end()) {
+            _hits++;
+            _lru.splice(_lru.begin(), _lru, it->second);  // Ƶͷ
+            return it->second->second;
+        }
+
+        _misses++;
+        _prog.compile(_key.c_str());
+        double res = (_prog.valid() && _prog.varCount() == 0) ? _prog.eval() : NAN;
+        if (_lru.size() >= _capacity) {  // ̭δõĿڵƵͷ
+            _index.erase(_lru.back().first);
+            _lru.splice(_lru.begin(), _lru, --_lru.end());
+            _lru.front().first.swap(_key);
+            _lru.front().second = res;
+        } else {
+            _lru.push_front(Entry(_key, res));
+        }
+        _index[_lru.front().first] = _lru.begin();
+        return res;
+    }
+
+    // ջ
+    void clear() {
+        _lru.clear();
+        _index.clear();
+        _hits = _misses = 0;
+    }
+
+    // ͳϢ
+    size_t size() const { return _lru.size(); }
+    size_t capacity() const { return _capacity; }
+    long long hits() const { return _hits; }
+    long long misses() const { return _misses; }
+    double hitRate() const {
+        return (_hits + _misses) > 0 ? (double)_hits / (_hits + _misses) : 0;
+    }
+};
+
+#endif  // EXPR_CACHE_H
@@ -0,0 +1,224 @@
+#ifndef EXPR_STREAM_H
+#define EXPR_STREAM_H
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include "Expression.h"
+using namespace std;
+
+// ʽͳϢ
+struct StreamStats {
+    long long lines;  // 
+    long long bytes;  // ֽ
+    double seconds;   // ʱǽʱ䣩
+
+    StreamStats() : lines(0), bytes(0), seconds(0) {}
+    double linesPerSec() const { return seconds > 0 ? lines / seconds : 0; }
+    double mbPerSec() const { return seconds > 0 ? bytes / seconds / (1 << 20) : 0; }
+};
+
+// ˮеһ룺Уÿ'\n'β
+struct StreamPiece {
+    vector<char> text;  // 루иɼһ飩
+    string out;         // ÿһ
+    long long lines;    // 
+    bool done;          // Ƿ
+
+    StreamPiece(const char* begin, const char* end) : text(begin, end), lines(0), done(false) {}
+};
+
+// ÿ̵߳ļ㻷ջзʹ
+struct StreamWorker {
+    Stack<double> numStack;    // ջ
+    Stack<Operator> opStack;   // ջ
+
+    // ƬеÿһУ͵ذ'\n'滻Ϊ'\0'׷ӵp.out
+    void run(StreamPiece& p) {
+        char buf[32];
+        char* line = &p.text[0];
+        char* end = line + p.text.size();
+        while (line < end) {
+            char* eol = (char*)memchr(line, '\n', end - line);
+            *eol = '\0';
+            if (eol > line && eol[-1] == '\r') eol[-1] = '\0';  // CRLF
+            double res = stringCalculator(line, numStack, opStack);
+            if (isnan(res)) {
+                p.out.append("nan\n");
+            } else {
+                int n = snprintf(buf, sizeof(buf), "%.15g\n", res);
+                p.out.append(buf, n);
+            }
+            p.lines++;
+            line = eol + 1;
+        }
+    }
+};
+
+// ʽˮߣ߳гפȡƬμ㣻
+// ύ˳ǼƬΣٰͬ˳ȴд˳һ
+class StreamPipeline {
+private:
+    mutex _m;
+    condition_variable _ready;    // Ƭλˮ߹ر
+    condition_variable _done;     // Ƭ
+    deque<StreamPiece*> _todo;    // Ƭ
+    deque<StreamPiece*> _pending; // ύδдƬΣ˳
+    vector<StreamWorker> _workers;
+    vector<thread> _pool;
+    bool _closed;
+
+    StreamPipeline(const StreamPipeline&);
+    StreamPipeline& operator=(const StreamPipeline&);
+
+    // ̣߳ȡƬμ㣬ֱˮ߹ر
+    void serve(int k) {
+        while (true) {
+            StreamPiece* p;
+            {
+                unique_lock<mutex> lock(_m);
+                while (_todo.empty() && !_closed) _ready.wait(lock);
+                if (_todo.empty()) return;
+                p = _todo.front();
+                _todo.pop_front();
+            }
+            _workers[k].run(*p);
+            {
+                lock_guard<mutex> lock(_m);
+                p->done = true;
+            }
+            _done.notify_all();
+        }
+    }
+
+public:
+    StreamPipeline(int threads) : _workers(threads), _closed(false) {
+        for (int k = 0; k < threads; k++) _pool.push_back(thread(&StreamPipeline::serve, this, k));
+    }
+
+    // رգδʼƬΣȹ߳˳ͷȫƬ
+    ~StreamPipeline() {
+        {
+            lock_guard<mutex> lock(_m);
+            _todo.clear();
+            _closed = true;
+        }
+        _ready.notify_all();
+        for (size_t k = 0; k < _pool.size(); k++) _pool[k].join();
+        for (size_t i = 0; i < _pending.size(); i++) delete _pending[i];
+    }
+
+    // ύ[begin, end)е
+    void submit(const char* begin, const char* end) {
+        StreamPiece* p = new StreamPiece(begin, end);
+        _pending.push_back(p);
+        {
+            lock_guard<mutex> lock(_m);
+            _todo.push_back(p);
+        }
+        _ready.notify_one();
+    }
+
+    // ύδдƬ
+    size_t pending() const {
+        return _pending.size();
+    }
+
+    // ȴύƬ꣬дoutͷţдʧܷfalse
+    bool writeFront(FILE* out, StreamStats& st) {
+        StreamPiece* p = _pending.front();
+        {
+            unique_lock<mutex> lock(_m);
+            while (!p->done) _done.wait(lock);
+        }
+        _pending.pop_front();
+        bool ok = p->out.empty() || fwrite(p->out.data(), 1, p->out.size(), out) == p->out.size();
+        st.lines += p->lines;
+        delete p;
+        return ok;
+    }
+};
+
+// ʽ̼߳㣺inÿһʽoutа˳ÿһЧΪnan
+// ÿζchunkSizeֽڣб߽紦паб߽гthreadsƬνפḶ́߳
+// δİһ顣̼߳ʱ̼߳һ飻;Ƭβ2*threads
+// ڴռС޹ءдʱfalse
+bool evalStream(FILE* in, FILE* out, int threads = 0, size_t chunkSize = 8 << 20,
+                StreamStats* stats = NULL) {
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    if (threads <= 0) threads = (int)thread::hardware_concurrency();
+    if (threads <= 0) threads = 1;
+    StreamPipeline pipe(threads);
+    vector<char> buf(chunkSize + 1);
+    size_t carry = 0;  // һĩβδɵ
+    StreamStats st;
+
+    while (true) {
+        if (carry == buf.size() - 1) buf.resize(buf.size() * 2);  // гʱ󻺳
+        size_t got = fread(&buf[carry], 1, buf.size() - 1 - carry, in);
+        st.bytes += got;
+        size_t len = carry + got;
+        bool eof = (got == 0);
+        if (len == 0) break;
+
+        // еĽβһз֮󣻵ļĩβʱʣಿҲһ
+        size_t end = len;
+        if (!eof) {
+            while (end > 0 && buf[end - 1] != '\n') end--;
+            if (end == 0) {  // ûУ
+                carry = len;
+                continue;
+            }
+        } else if (buf[len - 1] != '\n') {
+            buf[len++] = '\n';  // ΪһвϻУԤ1ֽڣ
+            end = len;
+        }
+
+        // б߽[0, end)гthreadsΣύ;ƬιʱдƬ
+        size_t from = 0;
+        for (int k = 1; k <= threads && from < end; k++) {
+            size_t pos = max(from, end * k / threads);
+            while (pos < end && pos > 0 && buf[pos - 1] != '\n') pos++;
+            if (pos == from) continue;
+            if (pipe.pending() >= 2 * (size_t)threads && !pipe.writeFront(out, st)) return false;
+            pipe.submit(&buf[0] + from, &buf[0] + pos);
+            from = pos;
+        }
+
+        carry = len - end;
+        memmove(&buf[0], &buf[0] + end, carry);
+        if (eof) break;
+    }
+    while (pipe.pending() > 0) {
+        if (!pipe.writeFront(out, st)) return false;
+    }
+    if (ferror(in)) return false;  // ļĩβʹfread0뵥
+
+    st.seconds = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (stats != NULL) *stats = st;
+    return true;
+}
+
+// ļ汾inFileoutFile
+bool evalFile(const char* inFile, const char* outFile, int threads = 0, StreamStats* stats = NULL) {
+    FILE* in = fopen(inFile, "rb");
+    if (in == NULL) return false;
+    FILE* out = fopen(outFile, "wb");
+    if (out == NULL) {
+        fclose(in);
+        return false;
+    }
+    bool ok = evalStream(in, out, threads, 8 << 20, stats);
+    fclose(in);
+    if (fclose(out) != 0) ok = false;
+    return ok;
+}
+
+#endif  // EXPR_STREAM_H
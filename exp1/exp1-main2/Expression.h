@@ -0,0 +1,370 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+#include <cstring>
+#include <cctype>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Stack.h"  // ջģ
+using namespace std;
+
+// 壨ѭ˿ԡݽṹ4.6
+#define N_OPTR 9
+typedef enum { ADD, SUB, MUL, DIV, POW, FAC, L_P, R_P, EOE, INVALID } Operator;  // INVALIDЧַȼ
+
+// ȼ[ջ][ǰ]
+const char pri[N_OPTR][N_OPTR] = {
+    { '>', '>', '<', '<', '<', '<', '<', '>', '>' },  // +
+    { '>', '>', '<', '<', '<', '<', '<', '>', '>' },  // -
+    { '>', '>', '>', '>', '<', '<', '<', '>', '>' },  // *
+    { '>', '>', '>', '>', '<', '<', '<', '>', '>' },  // /
+    { '>', '>', '>', '>', '>', '<', '<', '>', '>' },  // ^
+    { '>', '>', '>', '>', '>', '>', ' ', '>', '>' },  // !
+    { '<', '<', '<', '<', '<', '<', '<', '=', ' ' },  // (
+    { ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ' },  // )
+    { '<', '<', '<', '<', '<', '<', '<', ' ', '=' }   // \0ֹ
+};
+
+// ַתö
+Operator charToOp(char c) {
+    switch (c) {
+        case '+': return ADD;
+        case '-': return SUB;
+        case '*': return MUL;
+        case '/': return DIV;
+        case '^': return POW;
+        case '!': return FAC;
+        case '(': return L_P;
+        case ')': return R_P;
+        case '\0': return EOE;
+        default: return INVALID;  // Ч
+    }
+}
+
+// ׳˱doubleܱʾ׳Ϊ170!nΪinf
+#define MAX_FACTORIAL 170
+
+struct FactorialTable {
+    double value[MAX_FACTORIAL + 1];
+
+    FactorialTable() {
+        value[0] = 1;
+        for (int i = 1; i <= MAX_FACTORIAL; ++i) value[i] = value[i - 1] * i;  // ˽ͬ
+    }
+};
+
+// ׳˼㣨ַ֧ǸСȡO(1)
+// doubleжϷΧȡNaN볬intΧֵת
+double factorial(double x) {
+    static const FactorialTable table;  // ״εʱ
+    if (isnan(x) || x <= -1) return NAN;  // Ч뷵NaN
+    if (x >= MAX_FACTORIAL + 1) return INFINITY;
+    return table.value[(int)x];
+}
+
+// ִ㣨a  bĿbĬ0
+double calculate(double a, Operator op, double b = 0) {
+    switch (op) {
+        case ADD: return a + b;
+        case SUB: return a - b;
+        case MUL: return a * b;
+        case DIV: return (b == 0) ? NAN : a / b;  // 㷵NaN
+        case POW: return pow(a, b);
+        case FAC: return factorial(a);             // ׳ˣĿ
+        default: return NAN;
+    }
+}
+
+// ַʽ
+// numStackopStackɵ÷ṩڶεü临ãÿ·
+double stringCalculator(const char* expr, Stack<double>& numStack, Stack<Operator>& opStack) {
+    numStack.clear();
+    opStack.clear();
+    opStack.push(EOE);         // ջѹֹ
+    int i = 0;
+    bool lastIsOp = true;      // һ token ǷΪ﷨飩
+    int len = strlen(expr);    // ֻһγȣÿѭظɨ
+
+    while (i <= len) {
+        char c = (i < len) ? expr[i] : '\0';  // 
+
+        // ֣С
+        if (isdigit(c) || (c == '.' && i > 0 && isdigit(expr[i-1]))) {
+            lastIsOp = false;  // ǵǰΪ
+            double num = 0;
+            // 
+            while (isdigit(c)) {
+                num = num * 10 + (c - '0');
+                c = expr[++i];
+            }
+            // С
+            if (c == '.') {
+                c = expr[++i];
+                double frac = 0.1;
+                while (isdigit(c)) {
+                    num += (c - '0') * frac;
+                    frac *= 0.1;
+                    c = expr[++i];
+                }
+            }
+            numStack.push(num);  // ջ
+        } 
+        // 
+        else {
+            Operator currOp = charToOp(c);
+            if (currOp == INVALID) return NAN;  // Ч
+
+            // 
+            if (c == '\0' || i == len) {
+                currOp = EOE;
+            }
+
+            // ﷨飺֣ "3(4)"  "3+*5"
+            if (!lastIsOp && (currOp == L_P || isdigit(c))) {
+                return NAN;
+            }
+
+            // Ƚջջջȼ
+            Operator topOp = opStack.top();
+            char cmp = pri[topOp][currOp];
+
+            if (cmp == '<') {  // ջȼͣǰջ
+                opStack.push(currOp);
+                lastIsOp = (currOp != R_P);  // Ų
+                i++;
+            } 
+            else if (cmp == '=') {  // ȼȣŶԣ
+                opStack.pop();  // 
+                if (currOp == EOE) break;  // ֹƥ䣬
+                lastIsOp = true;
+                i++;
+            } 
+            else if (cmp == '>') {  // ջȼߣִм
+                opStack.pop();
+                if (topOp == FAC) {  // Ŀ׳ˣ
+                    if (numStack.empty()) return NAN;
+                    double a = numStack.pop();
+                    double res = calculate(a, topOp);
+                    if (isnan(res)) return NAN;
+                    numStack.push(res);
+                } else {  // ˫Ŀ
+                    if (numStack.empty()) return NAN;
+                    double b = numStack.pop();
+                    if (numStack.empty()) return NAN;
+                    double a = numStack.pop();
+                    double res = calculate(a, topOp, b);
+                    if (isnan(res)) return NAN;
+                    numStack.push(res);
+                }
+            } 
+            else {  // ȼΪոЧʽ
+                return NAN;
+            }
+        }
+    }
+
+    // ջӦʣһ
+    if (numStack.size() != 1) return NAN;
+    return numStack.top();
+}
+
+double stringCalculator(const char* expr) {
+    Stack<double> numStack;    // ջ
+    Stack<Operator> opStack;   // ջ
+    return stringCalculator(expr, numStack, opStack);
+}
+
+// ָֽopΪADD~FACʱִжӦ㣬ȡָ
+enum { PUSH_NUM = INVALID + 1, PUSH_VAR = INVALID + 2 };
+
+struct Instr {
+    int op;   // 
+    int arg;  // PUSH_NUM±ꣻPUSH_VAR±
+};
+
+// ıʽһνɺ׺ֽ룬֮ɷֵ
+// ֧֡ĸ»߿ͷ+ - * / ^ ! ţհַ
+class ExprProgram {
+private:
+    vector<Instr> _code;            // ׺ʽָ
+    vector<double> _consts;         // 
+    vector<string> _vars;           // ±꼴ֵʱλã
+    int _depth;                     // ֵջ
+    bool _valid;                    // Ƿɹ
+    bool _fold;                     // Ƿ۵
+    mutable vector<double> _stack;  // eval(vars)ʹõֵջ
+
+    // һָջ
+    // ۵ǳʱڱ滻Ϊһȡָ
+    // ΪNaN㣨3/0۵ֵʱԭΪЧ
+    void emit(Operator op, int& depth) {
+        int n = (int)_code.size();
+        if (_fold && op == FAC && n >= 1 && _code[n - 1].op == PUSH_NUM) {
+            double v = calculate(_consts[_code[n - 1].arg], FAC);
+            if (!isnan(v)) {
+                _consts[_code[n - 1].arg] = v;
+                return;
+            }
+        } else if (_fold && op != FAC && n >= 2 && _code[n - 1].op == PUSH_NUM && _code[n - 2].op == PUSH_NUM) {
+            double v = calculate(_consts[_code[n - 2].arg], op, _consts[_code[n - 1].arg]);
+            if (!isnan(v)) {
+                _consts[_code[n - 2].arg] = v;
+                _code.pop_back();
+                depth--;
+                return;
+            }
+        }
+        Instr in = { op, 0 };
+        _code.push_back(in);
+        if (op != FAC) depth--;  // ˫Ŀ㵯ѹһ
+    }
+
+    // һȡָ
+    void emitPush(int op, int arg, int& depth) {
+        Instr in = { op, arg };
+        _code.push_back(in);
+        if (++depth > _depth) _depth = depth;
+    }
+
+    // Ӧ±꣬״γʱǼ
+    int addVar(const char* name, int len) {
+        for (int i = 0; i < (int)_vars.size(); i++) {
+            if ((int)_vars[i].size() == len && _vars[i].compare(0, len, name, len) == 0) return i;
+        }
+        _vars.push_back(string(name, len));
+        return (int)_vars.size() - 1;
+    }
+
+public:
+    ExprProgram() : _depth(0), _valid(false), _fold(true) {}
+    ExprProgram(const char* expr, bool fold = true) : _depth(0), _valid(false), _fold(fold) { compile(expr); }
+
+    // ʽȼpri׺ʽתΪ׺ָ﷨ʱfalse
+    bool compile(const char* expr) {
+        _code.clear();
+        _consts.clear();
+        _vars.clear();
+        _depth = 0;
+        _valid = false;
+        if (expr == NULL) return false;
+
+        Stack<Operator> opStack;   // ջ
+        opStack.push(EOE);         // ջѹֹ
+        bool expectOperand = true; // һǺǷӦΪ
+        int depth = 0;             // ǰջ
+        const char* s = expr;
+
+        while (true) {
+            while (*s == ' ' || *s == '\t' || *s == '\r' || *s == '\n') s++;
+            char c = *s;
+
+            // ֣С
+            if (isdigit((unsigned char)c)) {
+                if (!expectOperand) return false;
+                double num = 0;
+                while (isdigit((unsigned char)*s)) num = num * 10 + (*s++ - '0');
+                if (*s == '.') {
+                    s++;
+                    double frac = 0.1;
+                    while (isdigit((unsigned char)*s)) {
+                        num += (*s++ - '0') * frac;
+                        frac *= 0.1;
+                    }
+                }
+                _consts.push_back(num);
+                emitPush(PUSH_NUM, (int)_consts.size() - 1, depth);
+                expectOperand = false;
+                continue;
+            }
+
+            // 
+            if (isalpha((unsigned char)c) || c == '_') {
+                if (!expectOperand) return false;
+                const char* begin = s;
+                while (isalnum((unsigned char)*s) || *s == '_') s++;
+                emitPush(PUSH_VAR, addVar(begin, (int)(s - begin)), depth);
+                expectOperand = false;
+                continue;
+            }
+
+            // 
+            Operator currOp = charToOp(c);
+            if (currOp == INVALID) return false;  // Чַ
+            if (currOp == L_P) {
+                if (!expectOperand) return false;       // "3(4)"
+            } else if (expectOperand) {
+                return false;                           // "3+*5""()"ĩβȱ
+            }
+
+            // ջȼʱ
+            while (pri[opStack.top()][currOp] == '>') emit(opStack.pop(), depth);
+            char cmp = pri[opStack.top()][currOp];
+            if (cmp == '<') {
+                opStack.push(currOp);
+                if (currOp != FAC) expectOperand = true;  // ׳Ϊ׺
+            } else if (cmp == '=') {
+                opStack.pop();  // Իֹ
+                if (currOp == EOE) break;
+            } else {
+                return false;   // ȼΪոŲƥ
+            }
+            s++;
+        }
+
+        _valid = (depth == 1);
+        _stack.resize(_depth);
+        return _valid;
+    }
+
+    // ֵvarsθֵstackΪ÷ṩstackDepth()ԪصĻ
+    // κڴ䣬ڶ߳ԸԵstackãʽvarsΪNULLʱNaN
+    double eval(const double* vars, double* stack) const {
+        if (!_valid || (vars == NULL && !_vars.empty())) return NAN;
+        int top = 0;
+        const Instr* pc = _code.empty() ? NULL : &_code[0];
+        const Instr* end = pc + _code.size();
+        for (; pc != end; ++pc) {
+            switch (pc->op) {
+                case PUSH_NUM: stack[top++] = _consts[pc->arg]; continue;
+                case PUSH_VAR: stack[top++] = vars[pc->arg]; break;  // ΪNaNʱΪNaNExprBatchһ£
+                case FAC: stack[top - 1] = factorial(stack[top - 1]); break;
+                default:
+                    top--;
+                    stack[top - 1] = calculate(stack[top - 1], (Operator)pc->op, stack[top]);
+                    break;
+            }
+            if (isnan(stack[top - 1])) return NAN;  // stringCalculatorһ£Ч㼴Ч
+        }
+        return stack[0];
+    }
+
+    // ֵʹڲֵջͬһ󲻿ڶ߳вã
+    double eval(const double* vars = NULL) const {
+        return eval(vars, _stack.empty() ? NULL : &_stack[0]);
+    }
+
+    // Ƿɹ
+    bool valid() const { return _valid; }
+
+    // ֵջ
+    int stackDepth() const { return _depth; }
+
+    // ָָ
+    int length() const { return (int)_code.size(); }
+    const Instr& instr(int i) const { return _code[i]; }
+
+    // 
+    double constant(int i) const { return _consts[i]; }
+
+    // Ϣ
+    int varCount() const { return (int)_vars.size(); }
+    const string& varName(int i) const { return _vars[i]; }
+    int varIndex(const char* name) const {
+        for (int i = 0; i < (int)_vars.size(); i++) {
+            if (_vars[i] == name) return i;
+        }
+        return -1;
+    }
+};
+
+#endif  // EXPRESSION_H
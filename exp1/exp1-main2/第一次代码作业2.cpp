@@ -1,154 +1,14 @@
 #include <iostream>
 #include <cstring>
 #include <cmath>
+#include <ctime>
 #include "Stack.h"  // ջģ
+#include "Expression.h"  // 塢ȼֵ
+#include "ExprBatch.h"   // ֵ
+#include "ExprStream.h"  // ļʽ̼߳
+#include "ExprCache.h"   // 
 using namespace std;
 
-// 壨ѭ˿ԡݽṹ4.6
-#define N_OPTR 9
-typedef enum { ADD, SUB, MUL, DIV, POW, FAC, L_P, R_P, EOE } Operator;
-
-// ȼ[ջ][ǰ]
-const char pri[N_OPTR][N_OPTR] = {
-    { '>', '>', '<', '<', '<', '<', '<', '>', '>' },  // +
-    { '>', '>', '<', '<', '<', '<', '<', '>', '>' },  // -
-    { '>', '>', '>', '>', '<', '<', '<', '>', '>' },  // *
-    { '>', '>', '>', '>', '<', '<', '<', '>', '>' },  // /
-    { '>', '>', '>', '>', '>', '<', '<', '>', '>' },  // ^
-    { '>', '>', '>', '>', '>', '>', ' ', '>', '>' },  // !
-    { '<', '<', '<', '<', '<', '<', '<', '=', ' ' },  // (
-    { ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ', ' ' },  // )
-    { '<', '<', '<', '<', '<', '<', '<', ' ', '=' }   // \0ֹ
-};
-
-// ַתö
-Operator charToOp(char c) {
-    switch (c) {
-        case '+': return ADD;
-        case '-': return SUB;
-        case '*': return MUL;
-        case '/': return DIV;
-        case '^': return POW;
-        case '!': return FAC;
-        case '(': return L_P;
-        case ')': return R_P;
-        case '\0': return EOE;
-        default: return (Operator)-1;  // Ч
-    }
-}
-
-// ׳˼㣨ַ֧Ǹ
-double factorial(int n) {
-    if (n < 0) return NAN;  // Ч뷵NaN
-    double res = 1;
-    for (int i = 2; i <= n; ++i) res *= i;
-    return res;
-}
-
-// ִ㣨a  bĿbĬ0
-double calculate(double a, Operator op, double b = 0) {
-    switch (op) {
-        case ADD: return a + b;
-        case SUB: return a - b;
-        case MUL: return a * b;
-        case DIV: return (b == 0) ? NAN : a / b;  // 㷵NaN
-        case POW: return pow(a, b);
-        case FAC: return factorial((int)a);       // ׳ˣĿ
-        default: return NAN;
-    }
-}
-
-// ַʽ
-double stringCalculator(const char* expr) {
-    Stack<double> numStack;    // ջ
-    Stack<Operator> opStack;   // ջ
-    opStack.push(EOE);         // ջѹֹ
-    int i = 0;
-    bool lastIsOp = true;      // һ token ǷΪ﷨飩
-
-    while (i <= strlen(expr)) {
-        char c = (i < strlen(expr)) ? expr[i] : '\0';  // 
-
-        // ֣С
-        if (isdigit(c) || (c == '.' && i > 0 && isdigit(expr[i-1]))) {
-            lastIsOp = false;  // ǵǰΪ
-            double num = 0;
-            // 
-            while (isdigit(c)) {
-                num = num * 10 + (c - '0');
-                c = expr[++i];
-            }
-            // С
-            if (c == '.') {
-                c = expr[++i];
-                double frac = 0.1;
-                while (isdigit(c)) {
-                    num += (c - '0') * frac;
-                    frac *= 0.1;
-                    c = expr[++i];
-                }
-            }
-            numStack.push(num);  // ջ
-        } 
-        // 
-        else {
-            Operator currOp = charToOp(c);
-            if (currOp == (Operator)-1) return NAN;  // Ч
-
-            // 
-            if (c == '\0' || i == strlen(expr)) {
-                currOp = EOE;
-            }
-
-            // ﷨飺֣ "3(4)"  "3+*5"
-            if (!lastIsOp && (currOp == L_P || isdigit(c))) {
-                return NAN;
-            }
-
-            // Ƚջջջȼ
-            Operator topOp = opStack.top();
-            char cmp = pri[topOp][currOp];
-
-            if (cmp == '<') {  // ջȼͣǰջ
-                opStack.push(currOp);
-                lastIsOp = (currOp != R_P);  // Ų
-                i++;
-            } 
-            else if (cmp == '=') {  // ȼȣŶԣ
-                opStack.pop();  // 
-                if (currOp == EOE) break;  // ֹƥ䣬
-                lastIsOp = true;
-                i++;
-            } 
-            else if (cmp == '>') {  // ջȼߣִм
-                opStack.pop();
-                if (topOp == FAC) {  // Ŀ׳ˣ
-                    if (numStack.empty()) return NAN;
-                    double a = numStack.pop();
-                    double res = calculate(a, topOp);
-                    if (isnan(res)) return NAN;
-                    numStack.push(res);
-                } else {  // ˫Ŀ
-                    if (numStack.empty()) return NAN;
-                    double b = numStack.pop();
-                    if (numStack.empty()) return NAN;
-                    double a = numStack.pop();
-                    double res = calculate(a, topOp, b);
-                    if (isnan(res)) return NAN;
-                    numStack.push(res);
-                }
-            } 
-            else {  // ȼΪոЧʽ
-                return NAN;
-            }
-        }
-    }
-
-    // ջӦʣһ
-    if (numStack.size() != 1) return NAN;
-    return numStack.top();
-}
-
 // Լ
 void testCalculator() {
     const char* tests[] = {
@@ -177,7 +37,197 @@ void testCalculator() {
     }
 }
 
-int main() {
+// ԱֵstringCalculatorһգʾıʽ
+void testCompiled() {
+    const char* tests[] = {
+        "3+5*2", "(3+5)*2", "10/2-3", "2^3+4", "5!", "3+4*2/(1-5)",
+        "2.5+3.5*2", "5!+3*2", "3/0", "((3+5)", "3+*5", NULL
+    };
+    cout << "\n=== Աֵ ===" << endl;
+    for (int i = 0; tests[i] != NULL; i++) {
+        ExprProgram prog(tests[i]);
+        double a = stringCalculator(tests[i]);
+        double b = prog.eval();
+        bool same = (isnan(a) && isnan(b)) || a == b;
+        cout << "ʽ: " << tests[i] << "\t" << (same ? "һ" : "һ") << endl;
+    }
+
+    ExprProgram f("x*x + 2*y - (x-y)^2");
+    cout << "ʽ: x*x + 2*y - (x-y)^2" << f.length() << "ָ" << endl;
+    for (int k = 1; k <= 3; k++) {
+        double vars[2] = { (double)k, (double)(k + 1) };  // xy˳
+        cout << "x=" << vars[0] << ", y=" << vars[1] << "\t: " << f.eval(vars) << endl;
+    }
+    cout << "δֵ\t: " << f.eval() << endl;  // ÿָ룬õNaN
+
+    // ۵2^105!ڱ
+    ExprProgram raw("x*2^10+5!", false), folded("x*2^10+5!");
+    double x = 3;
+    cout << "ʽ: x*2^10+5!۵ǰ" << raw.length() << "ָ۵" << folded.length()
+         << "\tx=3 : " << folded.eval(&x) << endl;
+}
+
+// ܲԣͬһʽֵԱÿ½һκֵ
+void benchCompiled(int rounds = 1000000) {
+    const char* expr = "3+4*2/(1-5)^2+5!-2.5*(6-1)";
+    clock_t t0 = clock();
+    double s1 = 0;
+    for (int i = 0; i < rounds; i++) s1 += stringCalculator(expr);
+    double parseTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    ExprProgram prog(expr);
+    double s2 = 0;
+    for (int i = 0; i < rounds; i++) s2 += prog.eval();
+    double evalTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    cout << "\n=== Աֵܣ" << rounds << "Σ ===" << endl;
+    cout << "ν" << parseTime << " 룬ֵ" << evalTime << " 루"
+         << (s1 == s2 ? "һ" : "һ") << "" << endl;
+}
+
+// ܲԣ԰(x, y)ֵԱeval밴ֵ
+void benchBatch(int rows = 1000000) {
+    ExprProgram prog("x*x + 2*y - (x-y)^2 / (y-3) + x/y");
+    int ix = prog.varIndex("x"), iy = prog.varIndex("y");
+    vector<double> x(rows), y(rows), r1(rows), r2(rows);
+    srand(1);
+    for (int i = 0; i < rows; i++) {
+        x[i] = rand() % 1000 / 10.0;
+        y[i] = rand() % 100 / 10.0;  // y=0y=3NaN
+    }
+
+    clock_t t0 = clock();
+    double vars[2];
+    for (int i = 0; i < rows; i++) {
+        vars[ix] = x[i];
+        vars[iy] = y[i];
+        r1[i] = prog.eval(vars);
+    }
+    double rowTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    const double* columns[2];
+    columns[ix] = &x[0];
+    columns[iy] = &y[0];
+    ExprBatch batch(prog);
+    batch.eval(columns, rows, &r2[0]);
+    double batchTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    int diff = 0, nans = 0;
+    for (int i = 0; i < rows; i++) {
+        if (isnan(r1[i])) nans++;
+        if (!((isnan(r1[i]) && isnan(r2[i])) || r1[i] == r2[i])) diff++;
+    }
+    cout << "\n=== ֵ" << rows << "У ===" << endl;
+    cout << "У" << rowTime << " 루" << rows / rowTime << " /룩" << endl;
+    cout << "" << batchTime << " 루" << rows / batchTime << " /룩" << endl;
+    cout << "Ч " << nans << "һ " << diff << " " << endl;
+
+    // ΪNaNʱֵӦNaNpow(NaN, 0) == 1һ飩
+    const char* nanExprs[] = {"x^0", "x!", "0*x", "1^x"};
+    const int m = 8;
+    double nanIn[m];
+    for (int i = 0; i < m; i++) nanIn[i] = (i % 2) ? NAN : i;
+    int nanDiff = 0;
+    for (int e = 0; e < 4; e++) {
+        ExprProgram p(nanExprs[e]);
+        ExprBatch b(p);
+        const double* col = nanIn;
+        double out[m];
+        b.eval(&col, m, out);
+        for (int i = 0; i < m; i++) {
+            double r = p.eval(&nanIn[i]);
+            if (!((isnan(r) && isnan(out[i])) || r == out[i]) || (isnan(nanIn[i]) && !isnan(r))) nanDiff++;
+        }
+    }
+    cout << "NaN룺һ " << nanDiff << " " << endl;
+}
+
+// ļڱȶ
+string readAll(const char* file) {
+    string s;
+    FILE* fp = fopen(file, "rb");
+    if (fp == NULL) return s;
+    char buf[1 << 16];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) s.append(buf, n);
+    fclose(fp);
+    return s;
+}
+
+// ܲԣɰбʽļֱòͬ߳ʽ
+void benchStream(int lines = 1000000) {
+    const char* inFile = "exprs.txt";
+    const char* forms[] = { "%d+%d*%d", "(%d+%d)*%d", "%d/%d-%d", "%d^2+%d-%d",
+                            "%d+4*2/(1-%d)+%d", "(%d+%d)/(%d-5)", "((%d+%d)*%d" };
+    FILE* fp = fopen(inFile, "wb");
+    if (fp == NULL) return;
+    srand(1);
+    for (int i = 0; i < lines; i++) {
+        fprintf(fp, forms[rand() % 7], rand() % 100, rand() % 100, rand() % 10);
+        fputc('\n', fp);
+    }
+    fclose(fp);
+
+    cout << "\n=== ʽ㣨" << lines << "У ===" << endl;
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads <= 0) maxThreads = 1;
+    string first;
+    for (int threads = 1; ; threads = min(threads * 2, maxThreads)) {
+        StreamStats st;
+        evalFile(inFile, "results.txt", threads, &st);
+        string res = readAll("results.txt");
+        if (threads == 1) first = res;
+        cout << "߳ " << threads << "" << st.seconds << " 룬" << st.linesPerSec() << " /룬"
+             << st.mbPerSec() << " MB/루" << (res == first ? "һ" : "һ") << "" << endl;
+        if (threads == maxThreads) break;
+    }
+}
+
+// ܲԣظʽԱνLRU
+void benchCache(int rounds = 1000000, int distinct = 2000) {
+    vector<string> exprs(distinct);
+    char buf[96];
+    srand(2);
+    for (int i = 0; i < distinct; i++) {
+        snprintf(buf, sizeof(buf), "(%d+%d*(%d-2^10)/5!)*(%d-%d)^2/(1+%d)", rand() % 1000, rand() % 100,
+                 rand() % 50, rand() % 100, rand() % 100, rand() % 10);
+        exprs[i] = buf;
+    }
+    // ƫбķʷֲСŵıʽֵøƵ
+    vector<int> order(rounds);
+    for (int i = 0; i < rounds; i++) order[i] = (int)((double)distinct * pow(rand() / (RAND_MAX + 1.0), 3));
+
+    clock_t t0 = clock();
+    double s1 = 0;
+    Stack<double> numStack;
+    Stack<Operator> opStack;
+    for (int i = 0; i < rounds; i++) s1 += stringCalculator(exprs[order[i]].c_str(), numStack, opStack);
+    double directTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    double s2 = 0;
+    ExprCache cache(1024);
+    for (int i = 0; i < rounds; i++) s2 += cache.eval(exprs[order[i]].c_str());
+    double cacheTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    cout << "\n=== Խ棨" << rounds << "Σ" << distinct << "ֱʽ"
+         << cache.capacity() << " ===" << endl;
+    cout << "ν" << directTime << " 룬棺" << cacheTime << " 루 "
+         << cache.hitRate() * 100 << "%" << (s1 == s2 ? "һ" : "һ") << "" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // benchʱֻܲ
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchCompiled();
+        benchBatch();
+        benchStream();
+        benchCache();
+        return 0;
+    }
     testCalculator();  // в
+    testCompiled();
     return 0;
 }
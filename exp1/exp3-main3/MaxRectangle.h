@@ -0,0 +1,134 @@
+#ifndef MAX_RECTANGLE_H
+#define MAX_RECTANGLE_H
+#include <iostream>
+#include <string>
+#include "Stack.h"
+#include "Vector.h"
+using namespace std;
+
+// ״ͼջ޸룬ջɵṩʹ
+// ڱģɨ赽i == nʱ߶0׷Ԫ
+// ջn + 1ٷڴ棻lo/hiǿʱεзΧ[lo, hi)
+inline long long largestRectangleArea(const int* heights, int n, Stack<int>& stk,
+                                      int* lo = NULL, int* hi = NULL) {
+    stk.clear();
+    long long maxArea = 0;
+    int bestLo = 0, bestHi = 0;
+    for (int i = 0; i <= n; ++i) {
+        int h = (i < n) ? heights[i] : 0;  // ڱ
+        while (!stk.empty() && h < heights[stk.top()]) {
+            long long height = heights[stk.pop()];
+            int left = stk.empty() ? 0 : stk.top() + 1;
+            long long area = height * (i - left);
+            if (area > maxArea) {
+                maxArea = area;
+                bestLo = left;
+                bestHi = i;
+            }
+        }
+        stk.push(i);
+    }
+    if (lo != NULL) *lo = bestLo;
+    if (hi != NULL) *hi = bestHi;
+    return maxArea;
+}
+
+inline long long largestRectangleArea(const Vector<int>& heights, Stack<int>& stk) {
+    return heights.empty() ? 0 : largestRectangleArea(&heights[0], heights.size(), stk);
+}
+
+// 0/1ȫ1ӾΣʽ
+// ֻ浱ǰеߣÿ1ĸÿһO(cols)߲һ״ͼΣ
+// ڴΪO(cols)޹أʺжȡĴͼ
+class MaxRectangle {
+private:
+    int _cols;              // 
+    int* _height;           // еǰ
+    Stack<int> _stk;        // ջи
+    int _rows;              // Ѵ
+    long long _best;        // ĿǰΪֹ
+    int _top, _left;        // εϽǣСУ
+    int _bottom, _right;    // ε½ǣ
+
+    MaxRectangle(const MaxRectangle&);
+    MaxRectangle& operator=(const MaxRectangle&);
+
+    // Եǰһβ½
+    void update() {
+        int lo, hi;
+        long long area = largestRectangleArea(_height, _cols, _stk, &lo, &hi);
+        if (area > _best) {
+            _best = area;
+            _bottom = _rows;
+            _left = lo;
+            _right = hi;
+            _top = _rows - (int)(area / (hi - lo));
+        }
+    }
+
+public:
+    MaxRectangle(int cols) : _cols(cols > 0 ? cols : 0), _stk(_cols + 1) {
+        _height = new int[_cols > 0 ? _cols : 1];
+        reset();
+    }
+
+    ~MaxRectangle() {
+        delete[] _height;
+    }
+
+    // ״̬ʼµľ䣩
+    void reset() {
+        for (int j = 0; j < _cols; ++j) _height[j] = 0;
+        _rows = 0;
+        _best = 0;
+        _top = _left = _bottom = _right = 0;
+    }
+
+    // һУrow[j]ʾ1
+    template <typename T>
+    long long addRow(const T* row) {
+        for (int j = 0; j < _cols; ++j) _height[j] = row[j] ? _height[j] + 1 : 0;
+        _rows++;
+        update();
+        return _best;
+    }
+
+    // һı'1'ʾ1ַʾ0ȲĲְ0
+    long long addRow(const string& line) {
+        int n = (int)line.size() < _cols ? (int)line.size() : _cols;
+        for (int j = 0; j < n; ++j) _height[j] = (line[j] == '1') ? _height[j] + 1 : 0;
+        for (int j = n; j < _cols; ++j) _height[j] = 0;
+        _rows++;
+        update();
+        return _best;
+    }
+
+    // ѯ
+    long long area() const { return _best; }
+    int rows() const { return _rows; }
+    int cols() const { return _cols; }
+    int top() const { return _top; }
+    int left() const { return _left; }
+    int bottom() const { return _bottom; }
+    int right() const { return _right; }
+};
+
+// ȥβ'\r'CRLF
+inline void chompCR(string& line) {
+    if (!line.empty() && line[line.size() - 1] == '\r') line.erase(line.size() - 1);
+}
+
+// ıжȡ0/1ÿһ'0'/'1'ɵַȡһеĳȣȫ1Ӿ
+inline long long maximalRectangle(istream& in) {
+    string line;
+    if (!getline(in, line)) return 0;
+    chompCR(line);
+    MaxRectangle solver((int)line.size());
+    do {
+        chompCR(line);
+        solver.addRow(line);
+    } while (getline(in, line));
+    return solver.area();
+}
+
+#endif  // MAX_RECTANGLE_H
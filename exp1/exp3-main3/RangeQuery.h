@@ -0,0 +1,417 @@
+#ifndef RANGE_QUERY_H
+#define RANGE_QUERY_H
+#include <iostream>
+#include <cstdlib>
+#include <ctime>
+#include "Vector.h"
+using namespace std;
+
+// ѯVector֮ϣһΪҿ[lo, hi)Vector::remove(lo, hi)һ
+
+// ظ׵ĶԪ㣨min/maxϡ
+template <typename T>
+struct MinOp {
+    T operator()(const T& a, const T& b) const { return b < a ? b : a; }
+};
+
+template <typename T>
+struct MaxOp {
+    T operator()(const T& a, const T& b) const { return a < b ? b : a; }
+};
+
+// ϡԤO(n log n)̬ϵmin/maxѯO(1)
+// jiΪ[i, i + 2^j)Ľδͬһ
+template <typename T, typename Op = MinOp<T> >
+class SparseTable {
+private:
+    int _n;            // Ԫظ
+    int _levels;       // floor(log2(n)) + 1
+    T* _table;         // _table[j * n + i]
+    int* _log;         // _log[len] = floor(log2(len))
+    Op _op;
+
+    SparseTable(const SparseTable&);
+    SparseTable& operator=(const SparseTable&);
+
+public:
+    SparseTable(const Vector<T>& v) : _n(v.size()), _levels(1) {
+        _log = new int[_n + 1];
+        _log[0] = 0;
+        if (_n >= 1) _log[1] = 0;
+        for (int i = 2; i <= _n; ++i) _log[i] = _log[i / 2] + 1;
+        if (_n > 0) _levels = _log[_n] + 1;
+        _table = new T[(size_t)_levels * (_n > 0 ? _n : 1)];
+        for (int i = 0; i < _n; ++i) _table[i] = v[i];
+        for (int j = 1; j < _levels; ++j) {
+            T* cur = _table + (size_t)j * _n;
+            const T* prev = cur - _n;
+            int half = 1 << (j - 1);
+            for (int i = 0; i + (1 << j) <= _n; ++i) cur[i] = _op(prev[i], prev[i + half]);
+        }
+    }
+
+    ~SparseTable() {
+        delete[] _table;
+        delete[] _log;
+    }
+
+    // [lo, hi)ϵĽҪ0 <= lo < hi <= nοص2^j串
+    T query(int lo, int hi) const {
+        int j = _log[hi - lo];
+        const T* row = _table + (size_t)j * _n;
+        return _op(row[lo], row[hi - (1 << j)]);
+    }
+
+    int size() const { return _n; }
+};
+
+// ״飨Fenwickǰ׺;ΪO(log n)
+// TΪԪͣSΪͣintԪlong long
+template <typename T, typename S = T>
+class FenwickTree {
+private:
+    int _n;
+    S* _tree;  // ±1ʼ_tree[i]Ϊ(i - lowbit(i), i]ĺ
+
+    FenwickTree(const FenwickTree&);
+    FenwickTree& operator=(const FenwickTree&);
+
+public:
+    // O(n)ÿڵԼĺͼӵڵ
+    FenwickTree(const Vector<T>& v) : _n(v.size()) {
+        _tree = new S[_n + 1];
+        _tree[0] = S();
+        for (int i = 1; i <= _n; ++i) _tree[i] = v[i - 1];
+        for (int i = 1; i <= _n; ++i) {
+            int p = i + (i & -i);
+            if (p <= _n) _tree[p] += _tree[i];
+        }
+    }
+
+    ~FenwickTree() {
+        delete[] _tree;
+    }
+
+    // iԪdelta
+    void add(int i, S delta) {
+        for (++i; i <= _n; i += i & -i) _tree[i] += delta;
+    }
+
+    // ǰ׺ͣ[0, i)
+    S prefix(int i) const {
+        S s = S();
+        for (; i > 0; i -= i & -i) s += _tree[i];
+        return s;
+    }
+
+    // ͣ[lo, hi)
+    S sum(int lo, int hi) const {
+        return prefix(hi) - prefix(lo);
+    }
+
+    int size() const { return _n; }
+};
+
+// ߶͡min/maxѯ㸳ֵ֧ӣΪO(log n)
+template <typename T, typename S = T>
+class SegmentTree {
+private:
+    int _n;
+    S* _sum;    // ڵ
+    T* _min;    // ڵСֵ
+    T* _max;    // ڵֵ
+    T* _lazy;   // δ´ӽڵ
+
+    SegmentTree(const SegmentTree&);
+    SegmentTree& operator=(const SegmentTree&);
+
+    void pull(int x) {
+        _sum[x] = _sum[2 * x] + _sum[2 * x + 1];
+        _min[x] = _min[2 * x] < _min[2 * x + 1] ? _min[2 * x] : _min[2 * x + 1];
+        _max[x] = _max[2 * x] < _max[2 * x + 1] ? _max[2 * x + 1] : _max[2 * x];
+    }
+
+    // ڵxlenԪأdelta
+    void apply(int x, int len, T delta) {
+        _sum[x] += (S)delta * len;
+        _min[x] += delta;
+        _max[x] += delta;
+        _lazy[x] += delta;
+    }
+
+    // ´ӽڵ
+    void push(int x, int lo, int mid, int hi) {
+        if (_lazy[x] != T()) {
+            apply(2 * x, mid - lo, _lazy[x]);
+            apply(2 * x + 1, hi - mid, _lazy[x]);
+            _lazy[x] = T();
+        }
+    }
+
+    void build(const Vector<T>& v, int x, int lo, int hi) {
+        _lazy[x] = T();
+        if (hi - lo == 1) {
+            _sum[x] = v[lo];
+            _min[x] = _max[x] = v[lo];
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        build(v, 2 * x, lo, mid);
+        build(v, 2 * x + 1, mid, hi);
+        pull(x);
+    }
+
+    void add(int ql, int qh, T delta, int x, int lo, int hi) {
+        if (ql <= lo && hi <= qh) {
+            apply(x, hi - lo, delta);
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        push(x, lo, mid, hi);
+        if (ql < mid) add(ql, qh, delta, 2 * x, lo, mid);
+        if (qh > mid) add(ql, qh, delta, 2 * x + 1, mid, hi);
+        pull(x);
+    }
+
+    void set(int i, T e, int x, int lo, int hi) {
+        if (hi - lo == 1) {
+            _sum[x] = e;
+            _min[x] = _max[x] = e;
+            _lazy[x] = T();
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        push(x, lo, mid, hi);
+        if (i < mid) set(i, e, 2 * x, lo, mid);
+        else set(i, e, 2 * x + 1, mid, hi);
+        pull(x);
+    }
+
+    // ѯ[ql, qh)ѽϲs/mn/mx
+    void query(int ql, int qh, int x, int lo, int hi, S& s, T& mn, T& mx) {
+        if (ql <= lo && hi <= qh) {
+            s += _sum[x];
+            if (_min[x] < mn) mn = _min[x];
+            if (mx < _max[x]) mx = _max[x];
+            return;
+        }
+        int mid = (lo + hi) / 2;
+        push(x, lo, mid, hi);
+        if (ql < mid) query(ql, qh, 2 * x, lo, mid, s, mn, mx);
+        if (qh > mid) query(ql, qh, 2 * x + 1, mid, hi, s, mn, mx);
+    }
+
+    // ѯڣǿ[lo, hi)
+    void query(int lo, int hi, S& s, T& mn, T& mx) {
+        s = S();
+        mn = _max[1];  // ڵֵµģΪֵ
+        mx = _min[1];
+        query(lo, hi, 1, 0, _n, s, mn, mx);
+    }
+
+public:
+    SegmentTree(const Vector<T>& v) : _n(v.size()) {
+        int cap = 4 * (_n > 0 ? _n : 1);
+        _sum = new S[cap];
+        _min = new T[cap];
+        _max = new T[cap];
+        _lazy = new T[cap];
+        if (_n > 0) build(v, 1, 0, _n);
+    }
+
+    ~SegmentTree() {
+        delete[] _sum;
+        delete[] _min;
+        delete[] _max;
+        delete[] _lazy;
+    }
+
+    // [lo, hi)ÿԪؼdelta
+    void add(int lo, int hi, T delta) {
+        if (lo < hi) add(lo, hi, delta, 1, 0, _n);
+    }
+
+    // iԪظֵΪe
+    void set(int i, T e) {
+        set(i, e, 1, 0, _n);
+    }
+
+    // iԪصĵǰֵ
+    T get(int i) {
+        int x = 1, lo = 0, hi = _n;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            push(x, lo, mid, hi);
+            if (i < mid) {
+                x = 2 * x;
+                hi = mid;
+            } else {
+                x = 2 * x + 1;
+                lo = mid;
+            }
+        }
+        return _min[x];
+    }
+
+    // ͡Сֵֵǿ[lo, hi)
+    S sum(int lo, int hi) {
+        S s;
+        T mn, mx;
+        query(lo, hi, s, mn, mx);
+        return s;
+    }
+
+    T min(int lo, int hi) {
+        S s;
+        T mn, mx;
+        query(lo, hi, s, mn, mx);
+        return mn;
+    }
+
+    T max(int lo, int hi) {
+        S s;
+        T mn, mx;
+        query(lo, hi, s, mn, mx);
+        return mx;
+    }
+
+    int size() const { return _n; }
+};
+
+// [lo, hi)0 <= lo < hi <= n
+inline void randomRange(int n, int& lo, int& hi) {
+    lo = (int)(((long long)rand() * RAND_MAX + rand()) % n);
+    hi = (int)(((long long)rand() * RAND_MAX + rand()) % n);
+    if (lo > hi) swap(lo, hi);
+    hi++;
+}
+
+// ܲԣͬһϵĴѯԱɨ衢ϡ״߶
+void benchRangeQuery(int n = 1000000, int queries = 1000000) {
+    cout << "\n=== ѯ" << n << "Ԫأ" << queries << "βѯ ===" << endl;
+    srand(2025);
+    Vector<int> v(n);
+    for (int i = 0; i < n; ++i) v.push_back(rand() % 105);
+    Vector<int> qlo(queries), qhi(queries);
+    for (int i = 0; i < queries; ++i) {
+        int lo, hi;
+        randomRange(n, lo, hi);
+        qlo.push_back(lo);
+        qhi.push_back(hi);
+    }
+
+    clock_t t0 = clock();
+    SparseTable<int, MinOp<int> > minTable(v);
+    SparseTable<int, MaxOp<int> > maxTable(v);
+    FenwickTree<int, long long> fenwick(v);
+    SegmentTree<int, long long> seg(v);
+    double buildTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // ɨֻѯ
+    int naiveQueries = queries / 1000 > 0 ? queries / 1000 : 1;
+    long long naiveSum = 0;
+    t0 = clock();
+    for (int i = 0; i < naiveQueries; ++i) {
+        int mn = v[qlo[i]];
+        for (int k = qlo[i]; k < qhi[i]; ++k) mn = v[k] < mn ? v[k] : mn;
+        naiveSum += mn;
+    }
+    double naiveTime = (double)(clock() - t0) / CLOCKS_PER_SEC * queries / naiveQueries;
+
+    long long s1 = 0, s2 = 0, s3 = 0, s4 = 0;
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) s1 += minTable.query(qlo[i], qhi[i]);
+    double sparseTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) s2 += seg.min(qlo[i], qhi[i]);
+    double segMinTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) s3 += fenwick.sum(qlo[i], qhi[i]);
+    double fenwickTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) s4 += seg.sum(qlo[i], qhi[i]);
+    double segSumTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    long long check = 0;
+    for (int i = 0; i < naiveQueries; ++i) check += minTable.query(qlo[i], qhi[i]);
+
+    cout << "ϡminmax״顢߶" << buildTime << " " << endl;
+    cout << "СֵɨԼ " << naiveTime << " 룬ϡ " << sparseTime << " 룬߶ "
+         << segMinTime << " 루" << (check == naiveSum && s1 == s2 ? "һ" : "һ") << "" << endl;
+    cout << "ͣ״ " << fenwickTime << " 룬߶ " << segSumTime << " 루"
+         << (s3 == s4 ? "һ" : "һ") << "" << endl;
+
+    // ̬״鵥߶뵥㸳ֵ
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) fenwick.add(qlo[i], rand() % 11 - 5);
+    double pointTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < queries; ++i) {
+        if (i % 2 == 0) seg.add(qlo[i], qhi[i], rand() % 11 - 5);
+        else seg.set(qlo[i], rand() % 105);
+    }
+    double rangeTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    cout << "£״鵥 " << pointTime << " 룬߶/㸳ֵ " << rangeTime << " " << endl;
+}
+
+// ȷԲԣУ
+void testRangeQuery(int n = 300, int ops = 20000) {
+    cout << "\n=== ѯȷԣ" << n << "Ԫأ" << ops << "β ===" << endl;
+    Vector<int> v(n);
+    for (int i = 0; i < n; ++i) v.push_back(rand() % 105);
+    Vector<int> ref = v;  // 飬߶ͬ
+    Vector<int> pts = v;  // 飬״ֻͬ
+    SparseTable<int, MinOp<int> > minTable(v);
+    SparseTable<int, MaxOp<int> > maxTable(v);
+    FenwickTree<int, long long> fenwick(v);
+    SegmentTree<int, long long> seg(v);
+
+    int bad = 0;
+    for (int t = 0; t < ops; ++t) {
+        int lo, hi;
+        randomRange(n, lo, hi);
+        // ̬ϡԭ
+        int mn = v[lo], mx = v[lo];
+        for (int k = lo; k < hi; ++k) {
+            mn = v[k] < mn ? v[k] : mn;
+            mx = mx < v[k] ? v[k] : mx;
+        }
+        if (minTable.query(lo, hi) != mn || maxTable.query(lo, hi) != mx) bad++;
+
+        // ̬ºѯ
+        switch (rand() % 3) {
+            case 0: {
+                int delta = rand() % 21 - 10;
+                seg.add(lo, hi, delta);
+                for (int k = lo; k < hi; ++k) ref[k] += delta;
+                break;
+            }
+            case 1: {
+                int e = rand() % 105;
+                seg.set(lo, e);
+                ref[lo] = e;
+                break;
+            }
+            default: {
+                int delta = rand() % 21 - 10;
+                fenwick.add(lo, delta);
+                pts[lo] += delta;
+                break;
+            }
+        }
+        randomRange(n, lo, hi);
+        long long s = 0, ps = 0;
+        mn = mx = ref[lo];
+        for (int k = lo; k < hi; ++k) {
+            s += ref[k];
+            ps += pts[k];
+            mn = ref[k] < mn ? ref[k] : mn;
+            mx = mx < ref[k] ? ref[k] : mx;
+        }
+        if (seg.sum(lo, hi) != s || seg.min(lo, hi) != mn || seg.max(lo, hi) != mx) bad++;
+        if (fenwick.sum(lo, hi) != ps || seg.get(lo) != ref[lo]) bad++;
+    }
+    cout << "ؽһ " << bad << " " << endl;
+}
+
+#endif  // RANGE_QUERY_H
@@ -3,24 +3,16 @@
 #include <ctime>
 #include "Stack.h"
 #include "Vector.h"
+#include "MaxRectangle.h"  // ޸İ汾밴ʽľ
+#include "RangeQuery.h"    // ϡ״߶
+#include <cstring>
 using namespace std;
 
 // ״ͼʹջģ飩
+// ʹڱheights׷Ԫ
 int largestRectangleArea(Vector<int>& heights) {
-    Stack<int> stk;
-    heights.push_back(0);  // ڱȷԪسջ
-    int maxArea = 0;
-    
-    for (int i = 0; i < heights.size(); ++i) {
-        while (!stk.empty() && heights[i] < heights[stk.top()]) {
-            int height = heights[stk.pop()];
-            int width = stk.empty() ? i : i - stk.top() - 1;
-            maxArea = max(maxArea, height * width);
-        }
-        stk.push(i);
-    }
-    heights.remove(heights.size() - 1);  // ָԭ
-    return maxArea;
+    Stack<int> stk(heights.size() + 1);
+    return (int)largestRectangleArea(heights, stk);
 }
 
 // ݲ
@@ -77,8 +69,77 @@ void testExamples() {
     cout << "" << largestRectangleArea(example2) << endl << endl;
 }
 
-int main() {
+// 0/1ȫ1ӾΣã
+long long bruteMaxRectangle(const Vector<Vector<char> >& m, int rows, int cols) {
+    long long best = 0;
+    for (int t = 0; t < rows; ++t) {
+        for (int l = 0; l < cols; ++l) {
+            int right = cols;  // (t, l)ΪϽʱǰȫ1Ͻ
+            for (int b = t; b < rows; ++b) {
+                int r = l;
+                while (r < right && m[b][r]) r++;
+                right = r;
+                if (right == l) break;
+                best = max(best, (long long)(b - t + 1) * (right - l));
+            }
+        }
+    }
+    return best;
+}
+
+// ԰ʽȫ1Ӿ
+void testMaxRectangle() {
+    cout << "=== 0/1ȫ1Ӿ ===" << endl;
+    const char* demo[] = {"10100", "10111", "11111", "10010"};
+    MaxRectangle solver(5);
+    for (int i = 0; i < 4; ++i) {
+        cout << demo[i] << endl;
+        solver.addRow(string(demo[i]));
+    }
+    cout << "" << solver.area() << "[" << solver.top() << ", " << solver.bottom()
+         << ")[" << solver.left() << ", " << solver.right() << ")" << endl;
+
+    // С뱩
+    int bad = 0;
+    for (int t = 0; t < 200; ++t) {
+        int rows = rand() % 12 + 1, cols = rand() % 12 + 1;
+        Vector<Vector<char> > m;
+        MaxRectangle s(cols);
+        for (int i = 0; i < rows; ++i) {
+            Vector<char> row;
+            for (int j = 0; j < cols; ++j) row.push_back(rand() % 4 != 0);
+            m.push_back(row);
+            s.addRow(&row[0]);
+        }
+        if (s.area() != bruteMaxRectangle(m, rows, cols)) bad++;
+    }
+    cout << "200뱩һ " << bad << " " << endl;
+}
+
+// ܲԣɡд
+void benchMaxRectangle(int rows = 5000, int cols = 4000) {
+    cout << "=== ȫ1ӾΣ" << rows << "x" << cols << " ===" << endl;
+    Vector<char> row(cols);
+    for (int j = 0; j < cols; ++j) row.push_back(0);
+    MaxRectangle big(cols);
+    clock_t t0 = clock();
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) row[j] = (rand() % 64 != 0);
+        big.addRow(&row[0]);
+    }
+    double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    cout << rows << "x" << cols << " " << big.area() << "ʱ " << sec << " " << endl;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchMaxRectangle();
+        benchRangeQuery();
+        return 0;
+    }
     testExamples();
     testRandomCases();
+    testMaxRectangle();
+    testRangeQuery();
     return 0;
 }
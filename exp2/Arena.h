@@ -0,0 +1,117 @@
+#ifndef ARENA_H
+#define ARENA_H
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+// Arenaϵͳڴ棬ʱƶָ
+// ֵ֧ͷţֻͨreset()һԻȫռ
+class Arena {
+private:
+    // ڴͷ֮Ե
+    struct Block {
+        Block* next;      // һ
+        size_t capacity;  // ֽͷ
+    };
+
+    Block* _head;         // ǰʹõĿ飨ͷ
+    Block* _free;         // reset()ɸõĿп
+    char* _cur;           // ǰһɷλ
+    char* _end;           // ǰĩβ
+    size_t _blockSize;    // ĬϿСֽڣ
+    size_t _used;         // ѷֽͳã
+
+    // ͷ֮ʼַ
+    static char* dataOf(Block* b) {
+        return reinterpret_cast<char*>(b) + sizeof(Block);
+    }
+
+    // һneedֽڵ¿飬Ϊǰ
+    void newBlock(size_t need) {
+        Block* b = NULL;
+        // ȸÿп
+        if (_free != NULL && _free->capacity >= need) {
+            b = _free;
+            _free = _free->next;
+        } else {
+            size_t cap = (need > _blockSize) ? need : _blockSize;
+            void* raw = malloc(sizeof(Block) + cap);
+            if (raw == NULL) throw std::bad_alloc();
+            b = static_cast<Block*>(raw);
+            b->capacity = cap;
+        }
+        b->next = _head;
+        _head = b;
+        _cur = dataOf(b);
+        _end = _cur + b->capacity;
+    }
+
+    // ͷеȫ
+    static void freeBlocks(Block* b) {
+        while (b != NULL) {
+            Block* next = b->next;
+            free(b);
+            b = next;
+        }
+    }
+
+    // ֹ
+    Arena(const Arena&);
+    Arena& operator=(const Arena&);
+
+public:
+    // 캯blockSizeΪÿϵͳĿСĬ1MB
+    Arena(size_t blockSize = 1 << 20)
+        : _head(NULL), _free(NULL), _cur(NULL), _end(NULL),
+          _blockSize(blockSize), _used(0) {}
+
+    // 黹п
+    ~Arena() {
+        freeBlocks(_head);
+        freeBlocks(_free);
+    }
+
+    // nֽڣalign루alignΪ2ݣ
+    void* allocate(size_t n, size_t align = sizeof(void*)) {
+        size_t addr = reinterpret_cast<size_t>(_cur);
+        size_t pad = (align - (addr & (align - 1))) & (align - 1);
+        if (_cur == NULL || pad + n > static_cast<size_t>(_end - _cur)) {
+            newBlock(n + align);
+            addr = reinterpret_cast<size_t>(_cur);
+            pad = (align - (addr & (align - 1))) & (align - 1);
+        }
+        char* p = _cur + pad;
+        _cur = p + n;
+        _used += n;
+        return p;
+    }
+
+    // һԻȫ䣺鱾Ա㸴ã黹ϵͳ
+    // ע⣺ö
+    void reset() {
+        while (_head != NULL) {
+            Block* next = _head->next;
+            _head->next = _free;
+            _free = _head;
+            _head = next;
+        }
+        _cur = _end = NULL;
+        _used = 0;
+    }
+
+    // ȫ䲢п黹ϵͳ
+    void release() {
+        freeBlocks(_head);
+        freeBlocks(_free);
+        _head = _free = NULL;
+        _cur = _end = NULL;
+        _used = 0;
+    }
+
+    // ѷֽ
+    size_t used() const {
+        return _used;
+    }
+};
+
+#endif  // ARENA_H
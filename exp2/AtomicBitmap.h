@@ -0,0 +1,186 @@
+#ifndef ATOMIC_BITMAP_H
+#define ATOMIC_BITMAP_H
+
+#include <atomic>
+#include <new>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include "Bitmap.h"
+
+// ǰ̵߳ıţ״εʱ䣬֮󲻱䣩ѡƬ
+inline unsigned int atomicBitmapSlot() {
+    static std::atomic<unsigned int> next(0);
+    static thread_local unsigned int slot = next.fetch_add(1);
+    return slot;
+}
+
+// λͼ߳̿ͬʱset/clear/testͬһλͼ
+// ڹʱ̶Ҫݣ޷벢д빲棩set/clearԣtestΪ0
+// ÿ޸Ƕ64λֵԭfetch_or/fetch_andɷصľֵжϸλǷĸı䣬
+// ͬһλ߳ͬʱsetʱǡһ̵߳õtrue
+// 1ĸڰ̷߳ƬļУռһУ߳ͬһ
+// ޸ڼsize()ǽֵ߳̽Ǿȷֵ
+// λʹrelaxedڴֻ֤λԭԣ̼߳䴫ݣ߳̽ʱjoinͬ
+class AtomicBitmap {
+private:
+    // Ƭ64ֽڶ벢䵽64ֽڣÿƬռһ
+    struct alignas(64) Shard {
+        std::atomic<long long> n;
+        char pad[64 - sizeof(std::atomic<long long>)];
+    };
+
+    std::atomic<BitWord>* M;
+    Rank N;
+    Shard* _shards;
+    char* _shardMem;  // Ƭڵԭʼڴ棺64ֽڣֹ루C++17֮ǰnew֤16ֽڵĶ룩
+    int _nShards;
+
+    AtomicBitmap(const AtomicBitmap&);
+    AtomicBitmap& operator=(const AtomicBitmap&);
+
+    void add(long long d) {
+        _shards[atomicBitmapSlot() % _nShards].n.fetch_add(d, std::memory_order_relaxed);
+    }
+
+public:
+    // shardsΪ0ʱӲ߳Ƭ
+    AtomicBitmap(Rank n, int shards = 0) {
+        N = (n + 63) / 64;
+        if (N < 1) N = 1;
+        M = new std::atomic<BitWord>[N];
+        for (Rank i = 0; i < N; i++) M[i].store(0, std::memory_order_relaxed);
+        _nShards = shards > 0 ? shards : (int)std::thread::hardware_concurrency();
+        if (_nShards <= 0) _nShards = 1;
+        _shardMem = new char[_nShards * sizeof(Shard) + 64];
+        _shards = (Shard*)(((uintptr_t)_shardMem + 63) & ~(uintptr_t)63);
+        for (int i = 0; i < _nShards; i++) {
+            new (&_shards[i]) Shard();
+            _shards[i].n.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~AtomicBitmap() {
+        delete[] M;
+        delete[] _shardMem;  // Shardƽֱͷڴ
+    }
+
+    // kλΪ1ظλǷ0Ϊ1
+    bool set(Rank k) {
+        if (k < 0 || k >= 64 * N) return false;
+        BitWord mask = bitmapMask(k);
+        BitWord old = M[k >> 6].fetch_or(mask, std::memory_order_relaxed);
+        if (old & mask) return false;
+        add(1);
+        return true;
+    }
+
+    // kλΪ0ظλǷ1Ϊ0
+    bool clear(Rank k) {
+        if (k < 0 || k >= 64 * N) return false;
+        BitWord mask = bitmapMask(k);
+        BitWord old = M[k >> 6].fetch_and(~mask, std::memory_order_relaxed);
+        if (!(old & mask)) return false;
+        add(-1);
+        return true;
+    }
+
+    // kλΪ1ԭֵڡ״ηʡжfalse̸߳k
+    bool testAndSet(Rank k) {
+        return !set(k);
+    }
+
+    // жϵkλǷΪ1
+    bool test(Rank k) const {
+        if (k < 0 || k >= 64 * N) return false;
+        return (M[k >> 6].load(std::memory_order_relaxed) & bitmapMask(k)) != 0;
+    }
+
+    // 1ĸƬ֮ͣ޸ڼΪֵ
+    Rank size() const {
+        long long s = 0;
+        for (int i = 0; i < _nShards; i++) s += _shards[i].n.load(std::memory_order_relaxed);
+        return (Rank)s;
+    }
+
+    // popcountͳƣУ飩
+    Rank count() const {
+        Rank c = 0;
+        for (Rank i = 0; i < N; i++) c += bitmapPopcount(M[i].load(std::memory_order_relaxed));
+        return c;
+    }
+
+    Rank capacity() const {
+        return 64 * N;
+    }
+
+    // ƵǰݵͨλͼbbУ벢޸ͬʱʱֻĳһʱ̸Ŀգ
+    void snapshot(Bitmap& b) const {
+        BitWord buf[256];
+        for (Rank w = 0; w < N; w += 256) {
+            Rank n = N - w < 256 ? N - w : 256;
+            for (Rank i = 0; i < n; i++) buf[i] = M[w + i].load(std::memory_order_relaxed);
+            b.mergeWords(w, buf, n);
+        }
+    }
+};
+
+// ̺߳keys[lo, hi)ͳƱ߳״αǵĸ
+inline void atomicBitmapMark(AtomicBitmap* b, const Rank* keys, int lo, int hi, Rank* first) {
+    Rank c = 0;
+    for (int i = lo; i < hi; i++) c += b->set(keys[i]);
+    *first = c;
+}
+
+// ̱߳ǣغʱ룬ʱ䣩
+inline double atomicBitmapRun(AtomicBitmap& b, const std::vector<Rank>& keys, int threads, Rank& first) {
+    std::vector<Rank> counts(threads, 0);
+    std::vector<std::thread> pool;
+    int n = (int)keys.size();
+    std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        pool.push_back(std::thread(atomicBitmapMark, &b, &keys[0], (int)((long long)n * t / threads),
+                                   (int)((long long)n * (t + 1) / threads), &counts[t]));
+    }
+    for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    first = 0;
+    for (int t = 0; t < threads; t++) first += counts[t];
+    return sec;
+}
+
+// ܲԣ̲߳ͬһλͼظ顰״αǡλͼ1ĸһ
+inline void benchAtomicBitmap(Rank n = 1 << 26, int marks = 1 << 24) {
+    int threads = (int)std::thread::hardware_concurrency();
+    if (threads < 4) threads = 4;
+    printf("\n=== Բλͼ%dλ%dαǣ%ḍ߳ ===\n", n, marks, threads);
+    std::vector<Rank> keys(marks);
+    srand(23);
+    for (int i = 0; i < marks; i++) keys[i] = (Rank)(((long long)rand() * RAND_MAX + rand()) % n);
+
+    // ߳ͨλͼΪ׼
+    clock_t c0 = clock();
+    Bitmap plain(n);
+    for (int i = 0; i < marks; i++) plain.set(keys[i]);
+    double plainTime = (double)(clock() - c0) / CLOCKS_PER_SEC;
+
+    Rank first1, firstN, firstShared;
+    AtomicBitmap single(n);
+    double t1 = atomicBitmapRun(single, keys, 1, first1);
+    AtomicBitmap sharded(n);
+    double tN = atomicBitmapRun(sharded, keys, threads, firstN);
+    AtomicBitmap shared(n, 1);  // ֻһ߳
+    double tS = atomicBitmapRun(shared, keys, threads, firstShared);
+
+    Bitmap copy(n);
+    sharded.snapshot(copy);
+    bool same = (firstN == plain.size() && sharded.size() == firstN && sharded.count() == firstN &&
+                 first1 == firstN && firstShared == firstN && copy.size() == plain.size());
+    for (Rank i = 0; same && i < plain.wordCount(); i++) same = (copy.words()[i] == plain.words()[i]);
+    printf("ͨBitmap̣߳%.3f \n", plainTime);
+    printf("AtomicBitmap1߳ %.3f 룬%d߳ %.3f 루һ %.3f 룩\n", t1, threads, tN, tS);
+    printf("״αǹ%dλͼ1%d%s\n", firstN, sharded.count(), same ? "һ" : "һ");
+}
+
+#endif // ATOMIC_BITMAP_H
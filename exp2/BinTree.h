@@ -2,6 +2,11 @@
 #define BINTREE_H
 
 #include <cstddef>  // NULL
+#include <cstdio>
+#include <ctime>
+#include <new>
+#include <type_traits>
+#include "Arena.h"  // 
 
 // ڵࣨģ֧࣬ͣ
 template <typename T>
@@ -26,18 +31,32 @@ private:
         if (node == NULL) return;
         destroy(node->left);  // 
         destroy(node->right); // 
-        delete node;          // ٵǰڵ
+        if (arena == NULL) delete node; // ٵǰڵ
+        else node->~BinNode<T>();       // ArenaеĽڵֻռArena
     }
 
+protected:
+    Arena* arena;     // ڵNULLʾʹnew/delete
+
 public:
-    // 캯Ĭϴ
-    BinTree() : root(NULL) {}
+    // 캯Ĭϴarenaǿʱڵarenaз䣬arenaø
+    BinTree(Arena* a = NULL) : root(NULL), arena(a) {}
 
     // Զͷڴ
+    // ʹArenaʱֱӶArena::reset()һԻ
     ~BinTree() {
+        if (arena != NULL && std::is_trivially_destructible<T>::value) return;
         destroy(root);
     }
 
+    // ӿڣڵ㣨protoΪģ帴ƹ죬ΪBinNodeࣩ
+    template <typename NodeT>
+    NodeT* createNode(const NodeT& proto) {
+        if (arena == NULL) return new NodeT(proto);
+        void* mem = arena->allocate(sizeof(NodeT), alignof(NodeT));
+        return new (mem) NodeT(proto);
+    }
+
     // ӿڣȡڵ㣨ֻ
     BinNode<T>* getRoot() const {
         return root;
@@ -56,4 +75,37 @@ public:
     }
 };
 
+// ܲԣnew/delete  Arena ַʽٰڵȫ
+inline void benchBinTreeArena(int n = 1000000, int rounds = 5) {
+    printf("=== Arena䣨%dڵ㣬%d֣ ===\n", n, rounds);
+    BinNode<int>** nodes = new BinNode<int>*[n];
+    Arena pool;
+    double heapTime = 0, arenaTime = 0;
+
+    for (int useArena = 0; useArena <= 1; useArena++) {
+        clock_t t0 = clock();
+        for (int r = 0; r < rounds; r++) {
+            BinTree<int>* tree = new BinTree<int>(useArena ? &pool : NULL);
+            // αţڵiĺΪ2i+12i+2
+            for (int i = 0; i < n; i++) {
+                nodes[i] = tree->createNode(BinNode<int>(i));
+            }
+            for (int i = 0; 2 * i + 1 < n; i++) {
+                nodes[i]->left = nodes[2 * i + 1];
+                if (2 * i + 2 < n) nodes[i]->right = nodes[2 * i + 2];
+            }
+            tree->setRoot(nodes[0]);
+            delete tree;
+            if (useArena) pool.reset();
+        }
+        double t = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        if (useArena) arenaTime = t;
+        else heapTime = t;
+    }
+    delete[] nodes;
+
+    printf("new/delete+ٹ %.3f \n", heapTime);
+    printf("Arena+ٹ %.3f \n", arenaTime);
+}
+
 #endif // BINTREE_H
@@ -2,114 +2,813 @@
 #define BITMAP_H
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <cstddef>  // NULL
+#include <ctime>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX  // windows.hmin/maxstd::min/maxͻ
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 // ͣλͼλ
 typedef int Rank;
 
+// λͼĴ洢Ԫ64λ
+typedef unsigned long long BitWord;
+
+// λ㣨GCC/ClangڽMSVCöӦintrinsic
+// ͳ1ĸ
+inline int bitmapPopcount(BitWord w) {
+#ifdef _MSC_VER
+    return (int)__popcnt64(w);
+#else
+    return __builtin_popcountll(w);
+#endif
+}
+
+// λ֮ǰ0ĸw != 0
+inline int bitmapClz(BitWord w) {
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanReverse64(&i, w);
+    return 63 - (int)i;
+#else
+    return __builtin_clzll(w);
+#endif
+}
+
+// ֽת
+inline BitWord bitmapBswap(BitWord w) {
+#ifdef _MSC_VER
+    return _byteswap_uint64(w);
+#else
+    return __builtin_bswap64(w);
+#endif
+}
+
+// λУkλλڵk/8ֽڡ0x80 >> (k % 8)Ϊ룬ԭȰֽڴ洢ʱڴ沼
+// ȫͬdumpļʽ䡣С˻൱е(k % 64) ^ 7λ
+inline BitWord bitmapMask(Rank k) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return 1ULL << (63 - (k & 63));
+#else
+    return 1ULL << ((k & 63) ^ 7);
+#endif
+}
+
+// ֱ任Ϊ߼˳򡱣ڵiλȣΪλĵiλclzɨ
+inline BitWord bitmapOrder(BitWord w) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return w;
+#else
+    return bitmapBswap(w);
+#endif
+}
+
+// ֻλͼͼӵڴ棬ֻⲿṩѯλBitmapͬ
+// вconstģӲڴ棻Χλ0
+// ָڴͼʹڼ䱣ЧBitmapδݡӳδ
+class BitmapView {
+private:
+    const BitWord* M;  // ⲿ
+    Rank N;            // 
+
+    // ӵwֵ߼λi𣨺һ1Ҳ-1
+    Rank scan(Rank w, int i) const {
+        if (w >= N) return -1;
+        BitWord x = bitmapOrder(M[w]) & (~0ULL >> i);
+        while (x == 0) {
+            if (++w >= N) return -1;
+            x = bitmapOrder(M[w]);
+        }
+        return 64 * w + bitmapClz(x);
+    }
+
+public:
+    BitmapView(const BitWord* words = NULL, Rank n = 0) : M(words), N(words != NULL ? n : 0) {}
+
+    // 
+    Rank capacity() const {
+        return 64 * N;
+    }
+
+    const BitWord* words() const {
+        return M;
+    }
+
+    Rank wordCount() const {
+        return N;
+    }
+
+    // жϵkλǷΪ1ΧΪ0
+    bool test(Rank k) const {
+        if (k < 0 || k >= 64 * N) return false;
+        return (M[k >> 6] & bitmapMask(k)) != 0;
+    }
+
+    // ͳֵΪ1λpopcount
+    Rank count() const {
+        Rank c = 0;
+        for (Rank i = 0; i < N; i++) c += bitmapPopcount(M[i]);
+        return c;
+    }
+
+    // һֵΪ1λû򷵻-1
+    Rank findFirst() const {
+        return scan(0, 0);
+    }
+
+    // kλ֮󣨲kĵһֵΪ1λû򷵻-1
+    Rank findNext(Rank k) const {
+        k++;
+        if (k <= 0) return findFirst();
+        return scan(k >> 6, k & 63);
+    }
+
+    // ȴС󣬶ÿֵΪ1λkvisit(k)
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (Rank w = 0; w < N; w++) {
+            BitWord x = bitmapOrder(M[w]);
+            while (x != 0) {
+                int i = bitmapClz(x);
+                visit(64 * w + i);
+                x &= ~(0x8000000000000000ULL >> i);
+            }
+        }
+    }
+
+    // ǰnλתΪַⲿͷڴ棩
+    char* bits2string(Rank n) const {
+        char* s = new char[n + 1]; // Ԥַλ
+        s[n] = '\0';
+        for (Rank i = 0; i < n; i++) {
+            s[i] = test(i) ? '1' : '0'; // 1'1'0'0'
+        }
+        return s;
+    }
+};
+
 class Bitmap {
+public:
+    // 洢ʽڴ棬ļĶд/ֻӳ
+    enum { HEAP_STORAGE, MAP_READ_WRITE, MAP_READ_ONLY };
+
 private:
-    unsigned char* M;   // 洢λͼݵֽ
-    Rank N;             // 鳤ȣֽӦ N*8 
+    BitWord* M;         // 洢λͼݵ飨ӳģʽֱָӳļݣ
+    Rank N;             // 鳤ȣӦ N*64 
     Rank _sz;           // ЧλĸֵΪ1λ
+    unsigned int _ver;  // ޸İ汾ţÿθıݻ洢ʱжǷ
+    int _mode;          // 洢ʽ
+#ifdef _WIN32
+    HANDLE _file, _mapping;
+#else
+    int _fd;
+#endif
+
+    // ӳصľΪδ
+    void initHandles() {
+        _mode = HEAP_STORAGE;
+#ifdef _WIN32
+        _file = INVALID_HANDLE_VALUE;
+        _mapping = NULL;
+#else
+        _fd = -1;
+#endif
+    }
+
+    // ѴļǰbytesֽӳΪMbytesΪ8ıʧܷfalse
+    bool mapFile(size_t bytes) {
+        bool ro = (_mode == MAP_READ_ONLY);
+#ifdef _WIN32
+        _mapping = CreateFileMappingA(_file, NULL, ro ? PAGE_READONLY : PAGE_READWRITE,
+                                      (DWORD)((unsigned long long)bytes >> 32), (DWORD)bytes, NULL);
+        if (_mapping == NULL) return false;
+        void* p = MapViewOfFile(_mapping, ro ? FILE_MAP_READ : FILE_MAP_WRITE, 0, 0, bytes);
+        if (p == NULL) return false;
+#else
+        void* p = mmap(NULL, bytes, ro ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED) return false;
+#endif
+        M = (BitWord*)p;
+        N = (Rank)(bytes / sizeof(BitWord));
+        return true;
+    }
+
+    // ӳ䣨ļִ򿪣
+    void unmapFile() {
+#ifdef _WIN32
+        if (M != NULL) UnmapViewOfFile(M);
+        if (_mapping != NULL) CloseHandle(_mapping);
+        _mapping = NULL;
+#else
+        if (M != NULL) munmap(M, (size_t)N * sizeof(BitWord));
+#endif
+        M = NULL;
+    }
+
+    // ļȸΪbytesWindows½ӳʱԶչ赥
+    bool resizeFile(size_t bytes) {
+#ifdef _WIN32
+        (void)bytes;
+        return true;
+#else
+        return ftruncate(_fd, (off_t)bytes) == 0;
+#endif
+    }
+
+    // ͷŴ洢ڴֱͷţӳӳ䲢رļ֮MΪNULL
+    void release() {
+        if (_mode == HEAP_STORAGE) {
+            delete[] M;
+            M = NULL;
+            return;
+        }
+        unmapFile();
+#ifdef _WIN32
+        if (_file != INVALID_HANDLE_VALUE) CloseHandle(_file);
+#else
+        if (_fd >= 0) ::close(_fd);
+#endif
+        initHandles();
+    }
+
+    // ֻӳ䲻޸
+    bool writable() const {
+        if (_mode != MAP_READ_ONLY) return true;
+        fprintf(stderr, "Error: Bitmap is mapped read-only.\n");
+        return false;
+    }
 
     // ʼλͼָʼ
     void init(Rank n) {
-        // ֽ(n+7)/8 ȡ
-        M = new unsigned char[N = (n + 7) / 8];
-        memset(M, 0, N); // ʼΪȫ0
+        // (n+63)/64 ȡһ
+        N = (n + 63) / 64;
+        if (N < 1) N = 1;
+        M = new BitWord[N];
+        memset(M, 0, N * sizeof(BitWord)); // ʼΪȫ0
         _sz = 0;         // ʼЧλΪ0
     }
 
-    // ݲʵλǰʱӱ
-    void expand(Rank k) {
-        if (k < 8 * N) return; // δ
-
+    // ݵn֣Ϊ0ֻӳ䲻ݣfalse
+    // дӳʧʱָԭȵӳ䣨ݲ䣩falseԭӳҲ޷ָʱ
+    // رļ˻ΪյĶڴλͼдļԱļУ
+    bool growTo(Rank n) {
+        if (n <= N) return true;
+        if (_mode == MAP_READ_ONLY) return false;
+        if (_mode == MAP_READ_WRITE) {  // ӳļӳ䣬ļΪ0
+            size_t bytes = (size_t)n * sizeof(BitWord), oldBytes = (size_t)N * sizeof(BitWord);
+            unmapFile();
+            _ver++;
+            if (resizeFile(bytes) && mapFile(bytes)) return true;
+            fprintf(stderr, "Error: Failed to grow mapped bitmap.\n");
+            if (!resizeFile(oldBytes) || !mapFile(oldBytes)) {
+                fprintf(stderr, "Error: Failed to restore mapped bitmap, falling back to an empty bitmap.\n");
+                release();
+                init(0);
+            }
+            return false;
+        }
         Rank oldN = N;
-        unsigned char* oldM = M;
-        init(2 * k);           // Ϊ 2*k أӱԣ
-        memcpy(M, oldM, oldN); // ԭݵ¿ռ
+        Rank oldSz = _sz;
+        BitWord* oldM = M;
+        init(64 * n);
+        memcpy(M, oldM, oldN * sizeof(BitWord)); // ԭݵ¿ռ
+        _sz = oldSz;
+        _ver++;
         delete[] oldM;         // ͷԭռ䣬ڴй©
+        return true;
+    }
+
+    // ݲʵλǰʱӱݣ޷ݣֻӳӳʧܣʱfalse
+    bool expand(Rank k) {
+        if (k < 64 * N) return true; // δ
+        return growTo((2 * k + 63) / 64); // Ϊ 2*k أӱԣ
+    }
+
+    // ߼λ[a, b)0 <= a < b <= 64Ӧ
+    static BitWord rangeMask(int a, int b) {
+        BitWord x = (~0ULL >> a) & ~(b >= 64 ? 0ULL : ~0ULL >> b);
+        return bitmapOrder(x); // ֽڷתģ߼˳洢˳ɻת
+    }
+
+    // ޸ĺͳЧλ°汾
+    void recount() {
+        _sz = count();
+        _ver++;
     }
 
 public:
     // 캯1Ĭ8أ
-    Bitmap(Rank n = 8) {
+    Bitmap(Rank n = 8) : _ver(0) {
+        initHandles();
         init(n);
     }
 
     // 캯2ָļȡλͼ
-    Bitmap(char* file, Rank n = 8) {
+    Bitmap(char* file, Rank n = 8) : _ver(0) {
+        initHandles();
         init(n);
         FILE* fp = fopen(file, "r");
         if (fp != NULL) {
-            fread(M, sizeof(char), N, fp);
+            fread(M, sizeof(char), (n + 7) / 8, fp);
             fclose(fp);
         }
-        // ͳЧλȷ_sz׼ȷ
-        _sz = 0;
-        for (Rank k = 0; k < n; k++) {
-            if (test(k)) _sz++;
+        // һֽеnλ֮ݲλͼpopcountλͳ[0, n)ͬ
+        if (n > 0) {
+            Rank w = n >> 6;
+            if (n & 63) M[w++] &= rangeMask(0, n & 63);
+            for (; w < N; w++) M[w] = 0;
+        }
+        _sz = count();
+    }
+
+    // 죺
+    Bitmap(const Bitmap& b) : _ver(0) {
+        initHandles();
+        init(64 * b.N);
+        memcpy(M, b.M, N * sizeof(BitWord));
+        _sz = b.size();
+    }
+
+    // ֵԭΪӳ䣬Ƚӳ䣬ڶڴУ
+    Bitmap& operator=(const Bitmap& b) {
+        if (this != &b) {
+            BitWord* old = NULL;
+            if (_mode == HEAP_STORAGE) old = M;  // bܾӳԴͷŷڸ֮
+            else release();
+            init(64 * b.N);
+            memcpy(M, b.M, N * sizeof(BitWord));
+            _sz = b.size();
+            _ver++;
+            delete[] old;
         }
+        return *this;
     }
 
     // ͷλͼڴ
     ~Bitmap() {
-        delete[] M;
-        M = NULL;
+        release();
         _sz = 0;
     }
 
+    // ӿڣӳļļݼλͼݣʽdumpͬǰݱ
+    // дӳ䣺ļ򴴽ȲΪ8ֽڵınλset/clearֱ޸ļ
+    //   ʱӳļӳ䣻̿ӳͬһļ
+    // ֻӳ䣺Ķʹã޸Ĳܾļλ0
+    bool map(const char* file, bool readOnly = false, Rank n = 0) {
+        release();
+        _mode = readOnly ? MAP_READ_ONLY : MAP_READ_WRITE;
+        size_t length = 0;
+#ifdef _WIN32
+        _file = CreateFileA(file, readOnly ? GENERIC_READ : GENERIC_READ | GENERIC_WRITE,
+                            FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, readOnly ? OPEN_EXISTING : OPEN_ALWAYS,
+                            FILE_ATTRIBUTE_NORMAL, NULL);
+        LARGE_INTEGER sz;
+        bool ok = (_file != INVALID_HANDLE_VALUE && GetFileSizeEx(_file, &sz));
+        if (ok) length = (size_t)sz.QuadPart;
+        // Windowsֻӳ䳬ļĩβĲֻ֣ʱֽȡ
+        size_t bytes = readOnly ? length / 8 * 8 : (length + 7) / 8 * 8;
+#else
+        _fd = ::open(file, readOnly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+        struct stat st;
+        bool ok = (_fd >= 0 && fstat(_fd, &st) == 0);
+        if (ok) length = (size_t)st.st_size;
+        // ĩβһֵĲļһҳͬҳӳ0
+        size_t bytes = (length + 7) / 8 * 8;
+#endif
+        if (!readOnly) {
+            size_t need = ((size_t)(n > 0 ? n : 1) + 63) / 64 * sizeof(BitWord);
+            if (bytes < need) bytes = need;
+            ok = ok && (bytes == length || resizeFile(bytes));
+        }
+        ok = ok && bytes > 0 && mapFile(bytes);
+        if (!ok) {
+            fprintf(stderr, "Error: Failed to map bitmap file %s.\n", file);
+            release();
+            init(8);
+            _ver++;
+            return false;
+        }
+        _sz = count();
+        _ver++;
+        return true;
+    }
+
+    // ӿڣӳ䣨ļУλͼΪյĶڴλͼ
+    void unmap() {
+        if (_mode == HEAP_STORAGE) return;
+        flush();
+        release();
+        init(8);
+        _ver++;
+    }
+
+    // ӿڣӳ޸ĵдļ
+    bool flush() {
+        if (_mode != MAP_READ_WRITE) return true;
+#ifdef _WIN32
+        return FlushViewOfFile(M, 0) && FlushFileBuffers(_file);
+#else
+        return msync(M, (size_t)N * sizeof(BitWord), MS_SYNC) == 0;
+#endif
+    }
+
+    // ӿڣ洢ʽ
+    int mode() const {
+        return _mode;
+    }
+
     // ӿڣȡЧλ
+    // ֻӳݿܱд߸ı䣬ÿͳ
     Rank size() const {
-        return _sz;
+        return _mode == MAP_READ_ONLY ? count() : _sz;
+    }
+
+    // ӿڣǰ
+    Rank capacity() const {
+        return 64 * N;
+    }
+
+    // ӿڣײ飨ֻ޸İ汾
+    const BitWord* words() const {
+        return M;
+    }
+
+    Rank wordCount() const {
+        return N;
+    }
+
+    unsigned int version() const {
+        return _ver;
     }
 
     // ӿڣkλΪ1Ԫأ
     void set(Rank k) {
-        expand(k); // ȷkΧ
-        // λ㣺λֽأΪ1
-        M[k >> 3] |= (0x80 >> (k & 0x07));
-        _sz++;
+        if (!writable() || !expand(k)) return; // ȷkΧ
+        BitWord& w = M[k >> 6];
+        BitWord mask = bitmapMask(k);
+        if (!(w & mask)) { // λԭΪ0ʱЧλ
+            w |= mask;
+            _sz++;
+            _ver++;
+        }
     }
 
     // ӿڣkλΪ0ɾԪأ
     void clear(Rank k) {
-        expand(k); // ȷkΧ
-        if (test(k)) { // λΪ1ʱżЧλ
-            // λ㣺λֽأΪ0
-            M[k >> 3] &= ~(0x80 >> (k & 0x07));
+        if (!writable() || !expand(k)) return; // ȷkΧ
+        BitWord& w = M[k >> 6];
+        BitWord mask = bitmapMask(k);
+        if (w & mask) { // λΪ1ʱżЧλ
+            w &= ~mask;
             _sz--;
+            _ver++;
         }
     }
 
+    // ӿڣǰݵֻͼBitmapݻӳʧЧ
+    BitmapView view() const {
+        return BitmapView(M, N);
+    }
+
     // ӿڣжϵkλǷΪ1бԪأ
-    bool test(Rank k) {
-        expand(k); // ȷkΧ
-        // λ㣺ĿλǷΪ1
-        return M[k >> 3] & (0x80 >> (k & 0x07));
+    // ֻݣλ0
+    bool test(Rank k) const {
+        return view().test(k);
+    }
+
+    // ӿڣͳֵΪ1λpopcount
+    Rank count() const {
+        return view().count();
+    }
+
+    // ӿڣһֵΪ1λû򷵻-1
+    Rank findFirst() const {
+        return view().findFirst();
+    }
+
+    // ӿڣkλ֮󣨲kĵһֵΪ1λû򷵻-1
+    Rank findNext(Rank k) const {
+        return view().findNext(k);
+    }
+
+    // ӿڣȴС󣬶ÿֵΪ1λkvisit(k)
+    template <typename VST>
+    void traverse(VST& visit) const {
+        view().traverse(visit);
+    }
+
+    // ӿڣ[lo, hi)еλȫΪ1˲һֵĲ봦
+    void setRange(Rank lo, Rank hi) {
+        if (!writable()) return;
+        if (lo < 0) lo = 0;
+        if (lo >= hi || !expand(hi - 1)) return;
+        Rank wl = lo >> 6, wh = (hi - 1) >> 6;
+        if (wl == wh) {
+            M[wl] |= rangeMask(lo & 63, ((hi - 1) & 63) + 1);
+        } else {
+            M[wl] |= rangeMask(lo & 63, 64);
+            for (Rank w = wl + 1; w < wh; w++) M[w] = ~0ULL;
+            M[wh] |= rangeMask(0, ((hi - 1) & 63) + 1);
+        }
+        recount();
+    }
+
+    // ӿڣ[lo, hi)еλȫΪ0Ĳֱ0
+    void clearRange(Rank lo, Rank hi) {
+        if (!writable()) return;
+        if (lo < 0) lo = 0;
+        if (hi > 64 * N) hi = 64 * N;
+        if (lo >= hi) return;
+        Rank wl = lo >> 6, wh = (hi - 1) >> 6;
+        if (wl == wh) {
+            M[wl] &= ~rangeMask(lo & 63, ((hi - 1) & 63) + 1);
+        } else {
+            M[wl] &= ~rangeMask(lo & 63, 64);
+            for (Rank w = wl + 1; w < wh; w++) M[w] = 0;
+            M[wh] &= ~rangeMask(0, ((hi - 1) & 63) + 1);
+        }
+        recount();
+    }
+
+    // ӿڣ[lo, hi)Ϊlo, lo+step, lo+2*step, ...λΪ1ɸбһı
+    // ʡȥsetλݣЧλ޷֧ķʽۼ
+    void setStride(Rank lo, Rank hi, Rank step) {
+        if (!writable() || step <= 0) return;
+        if (lo < 0) lo = 0;
+        if (lo >= hi || !expand(hi - 1)) return;
+        for (long long k = lo; k < hi; k += step) {
+            BitWord& w = M[k >> 6];
+            BitWord mask = bitmapMask((Rank)k);
+            _sz += (w & mask) == 0;
+            w |= mask;
+        }
+        _ver++;
+    }
+
+    // ӿڣֵļ㣨͵أѭ㹻򵥣Զ
+    // bĲ
+    Bitmap& operator&=(const Bitmap& b) {
+        if (!writable()) return *this;
+        Rank n = N < b.N ? N : b.N;
+        for (Rank i = 0; i < n; i++) M[i] &= b.M[i];
+        for (Rank i = n; i < N; i++) M[i] = 0;
+        recount();
+        return *this;
+    }
+
+    // ʱչb
+    Bitmap& operator|=(const Bitmap& b) {
+        if (!writable() || !growTo(b.N)) return *this;
+        for (Rank i = 0; i < b.N; i++) M[i] |= b.M[i];
+        recount();
+        return *this;
+    }
+
+    // ԳƲ
+    Bitmap& operator^=(const Bitmap& b) {
+        if (!writable() || !growTo(b.N)) return *this;
+        for (Rank i = 0; i < b.N; i++) M[i] ^= b.M[i];
+        recount();
+        return *this;
+    }
+
+    // ȥbΪ1λ
+    Bitmap& andNot(const Bitmap& b) {
+        if (!writable()) return *this;
+        Rank n = N < b.N ? N : b.N;
+        for (Rank i = 0; i < n; i++) M[i] &= ~b.M[i];
+        recount();
+        return *this;
+    }
+
+    // ת[0, n)еÿһλλͼɱ䣬ָΧn֮λ
+    Bitmap& flip(Rank n) {
+        if (n <= 0 || !writable() || !expand(n - 1)) return *this;
+        Rank wh = (n - 1) >> 6;
+        for (Rank w = 0; w < wh; w++) M[w] = ~M[w];
+        M[wh] ^= rangeMask(0, ((n - 1) & 63) + 1);
+        recount();
+        return *this;
+    }
+
+    // ӿڣsrcеnְλ򵽴ӵwֿʼλã룬ʱչ
+    void mergeWords(Rank w, const BitWord* src, Rank n) {
+        if (!writable()) return;
+        if (w + n > N) {  // expandһӱݣ˳εʱܰΪԣÿζһ
+            Rank twice = N < 0x7FFFFFFF / 128 ? 2 * N : 0x7FFFFFFF / 64;  // λRank
+            if (!growTo(w + n > twice ? w + n : twice)) return;
+        }
+        for (Rank i = 0; i < n; i++) {
+            BitWord x = M[w + i] | src[i];
+            _sz += bitmapPopcount(x) - bitmapPopcount(M[w + i]);
+            M[w + i] = x;
+        }
+        _ver++;
     }
 
     // ӿڣλͼݵָļ
     void dump(char* file) {
         FILE* fp = fopen(file, "w");
         if (fp != NULL) {
-            fwrite(M, sizeof(char), N, fp);
+            fwrite(M, sizeof(BitWord), N, fp);
             fclose(fp);
         }
     }
 
     // ӿڣǰnλתΪַʾ
-    char* bits2string(Rank n) {
-        expand(n - 1); // ȷλn-1Χ
-        char* s = new char[n + 1]; // Ԥַλ
-        s[n] = '\0';
-        for (Rank i = 0; i < n; i++) {
-            s[i] = test(i) ? '1' : '0'; // 1'1'0'0'
-        }
-        return s;
+    char* bits2string(Rank n) const {
+        return view().bits2string(n);
+    }
+};
+
+// 㣨Ǿ͵أΪµλͼ
+inline Bitmap operator&(const Bitmap& a, const Bitmap& b) {
+    Bitmap c(a);
+    return c &= b;
+}
+
+inline Bitmap operator|(const Bitmap& a, const Bitmap& b) {
+    Bitmap c(a);
+    return c |= b;
+}
+
+inline Bitmap operator^(const Bitmap& a, const Bitmap& b) {
+    Bitmap c(a);
+    return c ^= b;
+}
+
+inline Bitmap andNot(const Bitmap& a, const Bitmap& b) {
+    Bitmap c(a);
+    return c.andNot(b);
+}
+
+// [0, n)ΧڵĲ
+inline Bitmap complement(const Bitmap& a, Rank n) {
+    Bitmap c(a);
+    return c.flip(n);
+}
+
+// ͳƷʴķtraverse
+struct BitmapCounter {
+    Rank n;
+    long long sum;
+    BitmapCounter() : n(0), sum(0) {}
+    void operator()(Rank k) {
+        n++;
+        sum += k;
     }
 };
 
+// ܲԣλtest밴ִַʽͳơɨλ
+inline void benchBitmap(Rank n = 1 << 26, int density = 64) {
+    printf("\n=== λͼͳɨ裨%dλԼ1/%dΪ1 ===\n", n, density);
+    Bitmap b(n);
+    srand(7);
+    for (Rank k = 0; k < n / density; k++) b.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+
+    // λԭֻtest
+    clock_t t0 = clock();
+    Rank bitCount = 0;
+    long long bitSum = 0;
+    for (Rank k = 0; k < n; k++) {
+        if (b.test(k)) {
+            bitCount++;
+            bitSum += k;
+        }
+    }
+    double bitTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // ֣popcountͳƣclzɨ
+    t0 = clock();
+    Rank wordCount = b.count();
+    double countTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    long long scanSum = 0;
+    for (Rank k = b.findFirst(); k >= 0; k = b.findNext(k)) scanSum += k;
+    double scanTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    BitmapCounter visit;
+    b.traverse(visit);
+    double traverseTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    bool same = (bitCount == wordCount && wordCount == b.size() && visit.n == wordCount &&
+                 bitSum == scanSum && scanSum == visit.sum);
+    printf("λtestͳ+ɨ裺%.3f \n", bitTime);
+    printf("֣count %.4f 룬findFirst/findNext %.4f 룬traverse %.4f 루%dλΪ1%s\n",
+           countTime, scanTime, traverseTime, wordCount, same ? "һ" : "һ");
+
+    // Խtestݣλ0ֻͼͬ
+    Rank cap = b.capacity();
+    const Bitmap& cb = b;
+    BitmapView v = cb.view();
+    int outHits = 0, viewDiff = 0;
+    for (Rank k = 0; k < 1000000; k++) {
+        outHits += cb.test(cap + k * 64);
+        viewDiff += (v.test(k * 67) != cb.test(k * 67));
+    }
+    printf("Խ100Σ%s%dλ1Ĵ %dͼλͼһ %d \n",
+           b.capacity() == cap ? "" : "ı", cap, outHits, viewDiff);
+}
+
+// ܲԣλ밴ַʽλ
+inline void benchBitmapOps(Rank n = 1 << 26) {
+    printf("\n=== λͼ㣨%dλ ===\n", n);
+    Bitmap a(n), b(n);
+    srand(5);
+    for (Rank k = 0; k < n / 4; k++) {
+        a.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+        b.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+    }
+
+    // λtest + set/clear
+    clock_t t0 = clock();
+    Bitmap c(n);
+    for (Rank k = 0; k < n; k++) {
+        if (a.test(k) && b.test(k)) c.set(k);
+    }
+    double bitAnd = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    Bitmap r1(n);
+    for (Rank k = n / 4; k < 3 * (n / 4); k++) r1.set(k);
+    double bitRange = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // 
+    t0 = clock();
+    Bitmap d = a & b;
+    double wordAnd = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    Bitmap e = a | b, f = a ^ b, g = andNot(a, b);
+    double wordOthers = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    Bitmap r2(n);
+    r2.setRange(n / 4, 3 * (n / 4));
+    double wordRange = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // ݳϵУ飺|a| + |b| = |ab| + |ab||ab| = |ab| - |ab||a\b| = |a| - |ab|
+    bool same = (c.size() == d.size() && a.size() + b.size() == e.size() + d.size() &&
+                 f.size() == e.size() - d.size() && g.size() == a.size() - d.size() &&
+                 r1.size() == r2.size() && complement(r2, n).size() == n - r2.size());
+    printf("λ %.3f 룬 %.4f 룻ԳƲ %.4f \n", bitAnd, wordAnd, wordOthers);
+    printf("λ%dλλset %.3f 룬setRange %.4f 루%s\n", r2.size(), bitRange, wordRange,
+           same ? "һ" : "һ");
+}
+
+// ܲԣfread/fwriteݸڴӳַʽءλͼ
+inline void benchBitmapFile(Rank n = 1 << 28, int updates = 1000000) {
+    printf("\n=== λͼļ%dλ%d޸ģ ===\n", n, updates);
+    char file[] = "bitmap.bin";
+    srand(13);
+    {
+        Bitmap b(n);
+        for (int i = 0; i < updates; i++) b.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+        b.dump(file);
+    }
+
+    // Ʒʽݶ루λͳƣ޸ġд
+    clock_t t0 = clock();
+    Bitmap heap(file, n);
+    double loadTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < updates; i++) heap.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+    heap.dump(file);
+    double saveTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // ӳ䷽ʽֱļ޸ģдֻ漰ҳ
+    t0 = clock();
+    Bitmap mapped;
+    bool ok = mapped.map(file, false, n);
+    double mapTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    Bitmap reader;  // ͬһļֻӳ䣬ͬһ
+    ok = ok && reader.map(file, true);
+    t0 = clock();
+    for (int i = 0; i < updates; i++) mapped.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+    ok = ok && mapped.flush();
+    double flushTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    bool same = ok && mapped.size() == mapped.count() && reader.count() == mapped.size();
+    for (int i = 0; same && i < 1000; i++) {
+        Rank k = (Rank)(((long long)rand() * RAND_MAX + rand()) % n);
+        same = (reader.test(k) == mapped.test(k));
+    }
+    printf("fread %.3f 룬޸+fwrite %.3f \n", loadTime, saveTime);
+    printf("mmap %.4f 룬޸+flush %.3f 루ֻӳдӳ%s\n", mapTime, flushTime,
+           same ? "һ" : "һ");
+    reader.unmap();
+    mapped.unmap();
+    remove(file);
+}
+
 #endif // BITMAP_H
@@ -0,0 +1,181 @@
+#ifndef BITMAP_RANK_H
+#define BITMAP_RANK_H
+
+#include <algorithm>
+#include <vector>
+#include "Bitmap.h"
+
+// λͼrank/selectBitmap֮ϣ޸λͼ
+// rank(k)[0, k)1ĸselect(j)j10ƣ
+// ÿ2048λһ32λǰ1ÿ512λһ16λڳ飩
+// ռԼΪλͼ5%rankΪβ8popcountO(1)
+// selectÿ81921һڳ飬ֲ֮ҳ飬֣
+// ʱ಻飬ϡʱҲֻO(log(n/2048))
+// λͼ޸ĺ󣨰汾ű仯һβѯʱԶؽ
+class BitmapRank {
+public:
+    enum {
+        WORDS_PER_BLOCK = 8,    // ÿ512λ
+        BLOCKS_PER_SUPER = 4,   // ÿ2048λ
+        WORDS_PER_SUPER = WORDS_PER_BLOCK * BLOCKS_PER_SUPER,
+        SELECT_SAMPLE = 8192    // selectĲ1ĸƣ
+    };
+
+private:
+    const Bitmap& _bm;
+    mutable bool _built;                      // Ƿѽ
+    mutable unsigned int _ver;                // ʱλͼİ汾
+    mutable std::vector<unsigned int> _super;   // ֮ǰ1ĸĩβһΪ
+    mutable std::vector<unsigned short> _block; // 㵽ڳ֮1ĸ
+    mutable std::vector<unsigned int> _sample;  // i * SELECT_SAMPLE1ڵĳ
+    mutable Rank _total;                      // 1
+
+    // һɨ轨ȫ
+    void build() const {
+        const BitWord* M = _bm.words();
+        Rank nW = _bm.wordCount();
+        Rank nSuper = (nW + WORDS_PER_SUPER - 1) / WORDS_PER_SUPER;
+        Rank nBlock = (nW + WORDS_PER_BLOCK - 1) / WORDS_PER_BLOCK;
+        _super.assign(nSuper + 1, 0);
+        _block.assign(nBlock, 0);
+        _sample.clear();
+        Rank total = 0;
+        for (Rank s = 0; s < nSuper; s++) {
+            _super[s] = total;
+            Rank inSuper = 0;
+            for (Rank b = s * BLOCKS_PER_SUPER; b < (s + 1) * BLOCKS_PER_SUPER && b < nBlock; b++) {
+                _block[b] = (unsigned short)inSuper;
+                for (Rank w = b * WORDS_PER_BLOCK; w < (b + 1) * WORDS_PER_BLOCK && w < nW; w++) {
+                    inSuper += bitmapPopcount(M[w]);
+                }
+            }
+            total += inSuper;
+            // ڱеĲ
+            while ((Rank)_sample.size() * SELECT_SAMPLE < total) _sample.push_back(s);
+        }
+        _super[nSuper] = total;
+        _total = total;
+        _ver = _bm.version();
+        _built = true;
+    }
+
+    // λͼб仯ʱؽ
+    void refresh() const {
+        if (!_built || _ver != _bm.version()) build();
+    }
+
+public:
+    BitmapRank(const Bitmap& bm) : _bm(bm), _built(false), _ver(0), _total(0) {}
+
+    // [0, k)1ĸ
+    Rank rank(Rank k) const {
+        refresh();
+        if (k <= 0) return 0;
+        if (k >= _bm.capacity()) return _total;
+        const BitWord* M = _bm.words();
+        Rank w = k >> 6;
+        Rank b = w / WORDS_PER_BLOCK;
+        Rank r = _super[w / WORDS_PER_SUPER] + _block[b];
+        for (Rank i = b * WORDS_PER_BLOCK; i < w; i++) r += bitmapPopcount(M[i]);
+        int j = k & 63;
+        if (j > 0) r += bitmapPopcount(bitmapOrder(M[w]) >> (64 - j));
+        return r;
+    }
+
+    // j10ƣȣڷ-1
+    Rank select(Rank j) const {
+        refresh();
+        if (j < 0 || j >= _total) return -1;
+        const BitWord* M = _bm.words();
+        // ֲ֮ڳ飺_super[s] <= j < _super[s + 1]
+        Rank i = j / SELECT_SAMPLE;
+        Rank lo = _sample[i];
+        Rank hi = i + 1 < (Rank)_sample.size() ? _sample[i + 1] : (Rank)_super.size() - 2;
+        Rank s = (Rank)(std::upper_bound(&_super[lo + 1], &_super[hi + 1], (unsigned int)j) - &_super[0]) - 1;
+        Rank rem = j - _super[s];
+        // ҿ
+        Rank b = s * BLOCKS_PER_SUPER;
+        Rank bEnd = b + BLOCKS_PER_SUPER;
+        if (bEnd > (Rank)_block.size()) bEnd = (Rank)_block.size();
+        while (b + 1 < bEnd && _block[b + 1] <= rem) b++;
+        rem -= _block[b];
+        // 
+        Rank w = b * WORDS_PER_BLOCK;
+        for (int c; rem >= (c = bitmapPopcount(M[w])); w++) rem -= c;
+        // ڣȥǰrem1
+        BitWord x = bitmapOrder(M[w]);
+        for (; rem > 0; rem--) x &= ~(0x8000000000000000ULL >> bitmapClz(x));
+        return 64 * w + bitmapClz(x);
+    }
+
+    // 1
+    Rank count() const {
+        refresh();
+        return _total;
+    }
+
+    // ռõֽ
+    size_t memoryUsage() const {
+        return _super.capacity() * sizeof(unsigned int) + _block.capacity() * sizeof(unsigned short) +
+               _sample.capacity() * sizeof(unsigned int);
+    }
+};
+
+// ܲԣλ/rank/selectĲѯ£onesΪ1ĴĬn/2
+inline void benchBitmapRank(Rank n = 1 << 26, int queries = 1000000, Rank ones = -1) {
+    if (ones < 0) ones = n / 2;
+    printf("\n=== rank/select%dλԼ%d1%dβѯ ===\n", n, ones, queries);
+    Bitmap b(n);
+    srand(11);
+    for (Rank k = 0; k < ones; k++) b.set((Rank)(((long long)rand() * RAND_MAX + rand()) % n));
+    BitmapRank idx(b);
+
+    clock_t t0 = clock();
+    Rank total = idx.count();
+    double buildTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    std::vector<Rank> qk(queries), qj(queries);
+    for (int i = 0; i < queries; i++) {
+        qk[i] = (Rank)(((long long)rand() * RAND_MAX + rand()) % n);
+        qj[i] = (Rank)(((long long)rand() * RAND_MAX + rand()) % total);
+    }
+
+    // ֻѯΪÿβѯĺʱ
+    int few = 10;
+    long long naiveRank = 0, naiveSelect = 0;
+    t0 = clock();
+    for (int i = 0; i < few; i++) {
+        for (Rank k = 0; k < qk[i]; k++) naiveRank += b.test(k);
+    }
+    double naiveRankTime = (double)(clock() - t0) / CLOCKS_PER_SEC / few;
+    t0 = clock();
+    for (int i = 0; i < few; i++) {
+        Rank k = b.findFirst();
+        for (Rank j = 0; j < qj[i]; j++) k = b.findNext(k);
+        naiveSelect += k;
+    }
+    double naiveSelectTime = (double)(clock() - t0) / CLOCKS_PER_SEC / few;
+
+    long long rankSum = 0, selectSum = 0, check1 = 0, check2 = 0;
+    t0 = clock();
+    for (int i = 0; i < queries; i++) rankSum += idx.rank(qk[i]);
+    double rankTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int i = 0; i < queries; i++) selectSum += idx.select(qj[i]);
+    double selectTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    for (int i = 0; i < few; i++) {
+        check1 += idx.rank(qk[i]);
+        check2 += idx.select(qj[i]);
+    }
+    bool same = (check1 == naiveRank && check2 == naiveSelect);
+    for (int i = 0; same && i < 1000; i++) same = (idx.rank(idx.select(qj[i])) == qj[i]);
+
+    printf("%.4f 룬ռ %.2f%%\n", buildTime,
+           100.0 * idx.memoryUsage() / (b.wordCount() * sizeof(BitWord)));
+    printf("rankλtestÿԼ %.2f 룬ÿ %.1f \n", naiveRankTime * 1e3, rankTime * 1e9 / queries);
+    printf("selectfindNextÿԼ %.2f 룬ÿ %.1f \n", naiveSelectTime * 1e3,
+           selectTime * 1e9 / queries);
+    printf("У %lld / %lldؽ%s\n", rankSum, selectSum, same ? "һ" : "һ");
+}
+
+#endif // BITMAP_RANK_H
@@ -0,0 +1,292 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+#include <cmath>
+#include <set>
+#include <vector>
+#include "Bitmap.h"
+
+// 64λɢУsplitmix64ĩ˻ϣ˫䣬ͬļõͬɢֵ
+inline unsigned long long bloomMix(unsigned long long x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// ַɢУFNV-1aٻһ
+inline unsigned long long bloomHash(const char* s) {
+    unsigned long long h = 0xCBF29CE484222325ULL;
+    for (; *s; s++) {
+        h ^= (unsigned char)*s;
+        h *= 0x100000001B3ULL;
+    }
+    return bloomMix(h);
+}
+
+// ԤԪظnpλm = -n*ln(p)/(ln2)^2ȡ512λһ飩
+inline Rank bloomBits(Rank n, double p) {
+    if (n < 1) n = 1;
+    if (p <= 0 || p >= 1) p = 0.01;
+    double m = -n * log(p) / (log(2.0) * log(2.0));
+    double maxBits = 512.0 * ((0x7FFFFFFF / 512) - 1);  // Rankintλܳ2^31
+    if (m > maxBits) m = maxBits;
+    Rank blocks = (Rank)ceil(m / 512);
+    return 512 * (blocks < 1 ? 1 : blocks);
+}
+
+// ɢкk = (m/n)*ln2[1, 16]
+inline int bloomHashes(Rank n, Rank m) {
+    if (n < 1) n = 1;
+    int k = (int)((double)m / n * log(2.0) + 0.5);
+    return k < 1 ? 1 : (k > 16 ? 16 : k);
+}
+
+// һ̽Уɢֵĸ32λѡ飬˫ɢ g_i = a + i*b ڿȡkλ
+// bΪС2ݣ˿ڵkλͬ
+struct BloomProbe {
+    Rank block;
+    unsigned int a, b;
+
+    BloomProbe(unsigned long long h, Rank nBlocks) {
+        block = (Rank)(((h >> 32) * (unsigned long long)nBlocks) >> 32);
+        a = (unsigned int)h;
+        b = (unsigned int)(bloomMix(h) >> 32) | 1;
+    }
+
+    // iλã÷ȡڵĵλ
+    unsigned int at(int i) const {
+        return a + (unsigned int)i * b;
+    }
+};
+
+// BloomƵļϳԱжֻСڡ©
+// BitmapΪ洢512λ8֣64ֽڣֿ飺һkλͬһУ
+// һβѯֻһУBitmapڴnew䣬鲻һ64ֽڶ룬
+// ֿʹʱֵԸߣbenchBloomFilterиʵֵ
+class BloomFilter {
+public:
+    enum { BLOCK_BITS = 512 };
+
+private:
+    Bitmap _bits;
+    Rank _blocks;  // 
+    int _k;        // ÿλĸ
+
+public:
+    // ԤԪظnĿpȷС
+    BloomFilter(Rank n, double p = 0.01) : _bits(bloomBits(n, p)) {
+        _blocks = bloomBits(n, p) / BLOCK_BITS;
+        _k = bloomHashes(n, _blocks * BLOCK_BITS);
+    }
+
+    // ɢеļhӦΪȷֲ64λֵ
+    void addHash(unsigned long long h) {
+        BloomProbe pr(h, _blocks);
+        Rank base = pr.block * BLOCK_BITS;
+        for (int i = 0; i < _k; i++) _bits.set(base + (pr.at(i) & (BLOCK_BITS - 1)));
+    }
+
+    // жɢеļǷڼ
+    bool testHash(unsigned long long h) const {
+        BloomProbe pr(h, _blocks);
+        Rank base = pr.block * BLOCK_BITS;
+        for (int i = 0; i < _k; i++) {
+            if (!_bits.test(base + (pr.at(i) & (BLOCK_BITS - 1)))) return false;
+        }
+        return true;
+    }
+
+    void add(unsigned long long key) {
+        addHash(bloomMix(key));
+    }
+
+    void add(const char* key) {
+        addHash(bloomHash(key));
+    }
+
+    bool test(unsigned long long key) const {
+        return testHash(bloomMix(key));
+    }
+
+    bool test(const char* key) const {
+        return testHash(bloomHash(key));
+    }
+
+    // ͬĲͬnp죩ȼڰߵļ
+    BloomFilter& operator|=(const BloomFilter& f) {
+        if (f._blocks != _blocks || f._k != _k) {
+            fprintf(stderr, "Error: Cannot merge Bloom filters of different sizes.\n");
+            return *this;
+        }
+        _bits |= f._bits;
+        return *this;
+    }
+
+    // 
+    void reset() {
+        _bits.clearRange(0, _bits.capacity());
+    }
+
+    // ǰλʣ(λ/λ)^k
+    double estimatedFpr() const {
+        return pow((double)_bits.size() / _bits.capacity(), _k);
+    }
+
+    int hashCount() const {
+        return _k;
+    }
+
+    // λ
+    Rank bitCount() const {
+        return _bits.capacity();
+    }
+
+    // ײλͼֻ
+    const Bitmap& bits() const {
+        return _bits;
+    }
+};
+
+// Bloomÿλû4λ֧ɾ
+// ͬ64ֽڷֿ飨ÿ128ÿ1615󱥺ͣ
+// ɾʱ©СɾڼеļƻremoveֻtestΪʱִ
+class CountingBloomFilter {
+public:
+    enum { BLOCK_COUNTERS = 128, WORDS_PER_BLOCK = 8 };
+
+private:
+    std::vector<BitWord> _c;  // 
+    Rank _blocks;
+    int _k;
+
+    int counter(Rank j) const {
+        return (int)((_c[j >> 4] >> ((j & 15) * 4)) & 15);
+    }
+
+public:
+    // ͨλͬռ4ռ
+    CountingBloomFilter(Rank n, double p = 0.01) {
+        Rank m = bloomBits(n, p);
+        _blocks = (m + BLOCK_COUNTERS - 1) / BLOCK_COUNTERS;
+        _k = bloomHashes(n, _blocks * BLOCK_COUNTERS);
+        _c.assign((size_t)_blocks * WORDS_PER_BLOCK, 0);
+    }
+
+    void addHash(unsigned long long h) {
+        BloomProbe pr(h, _blocks);
+        Rank base = pr.block * BLOCK_COUNTERS;
+        for (int i = 0; i < _k; i++) {
+            Rank j = base + (pr.at(i) & (BLOCK_COUNTERS - 1));
+            if (counter(j) < 15) _c[j >> 4] += 1ULL << ((j & 15) * 4);
+        }
+    }
+
+    bool testHash(unsigned long long h) const {
+        BloomProbe pr(h, _blocks);
+        Rank base = pr.block * BLOCK_COUNTERS;
+        for (int i = 0; i < _k; i++) {
+            if (counter(base + (pr.at(i) & (BLOCK_COUNTERS - 1))) == 0) return false;
+        }
+        return true;
+    }
+
+    // ɾɢеļ϶ڼʱκ£false
+    bool removeHash(unsigned long long h) {
+        if (!testHash(h)) return false;
+        BloomProbe pr(h, _blocks);
+        Rank base = pr.block * BLOCK_COUNTERS;
+        for (int i = 0; i < _k; i++) {
+            Rank j = base + (pr.at(i) & (BLOCK_COUNTERS - 1));
+            if (counter(j) < 15) _c[j >> 4] -= 1ULL << ((j & 15) * 4);
+        }
+        return true;
+    }
+
+    void add(unsigned long long key) {
+        addHash(bloomMix(key));
+    }
+
+    void add(const char* key) {
+        addHash(bloomHash(key));
+    }
+
+    bool test(unsigned long long key) const {
+        return testHash(bloomMix(key));
+    }
+
+    bool test(const char* key) const {
+        return testHash(bloomHash(key));
+    }
+
+    bool remove(unsigned long long key) {
+        return removeHash(bloomMix(key));
+    }
+
+    bool remove(const char* key) {
+        return removeHash(bloomHash(key));
+    }
+
+    int hashCount() const {
+        return _k;
+    }
+
+    // 
+    Rank counterCount() const {
+        return _blocks * BLOCK_COUNTERS;
+    }
+};
+
+// ܲԣnnڼеļѯ£std::setԱ
+inline void benchBloomFilter(Rank n = 1000000, double p = 0.01) {
+    printf("\n=== Bloom%dĿ%.2f%% ===\n", n, p * 100);
+    // in+iͬɢкɢ
+    BloomFilter bf(n, p);
+    clock_t t0 = clock();
+    for (Rank i = 0; i < n; i++) bf.add((unsigned long long)i);
+    double addTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    t0 = clock();
+    Rank missed = 0, fp = 0;
+    for (Rank i = 0; i < n; i++) missed += !bf.test((unsigned long long)i);
+    for (Rank i = n; i < 2 * n; i++) fp += bf.test((unsigned long long)i);
+    double testTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    std::set<unsigned long long> s;
+    for (Rank i = 0; i < n; i++) s.insert(bloomMix(i));
+    t0 = clock();
+    Rank setHits = 0;
+    for (Rank i = 0; i < 2 * n; i++) setHits += (Rank)s.count(bloomMix(i));
+    double setTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    printf("%dλ%d KBk=%d %.3f 룬ѯ %.1f /루std::set %.1f /룬%d\n",
+           bf.bitCount(), bf.bitCount() / 8192, bf.hashCount(), addTime, 2 * n / testTime / 1e6,
+           2 * n / setTime / 1e6, setHits);
+    printf("ʣʵ %.3f%%λ %.3f%%© %d \n", 100.0 * fp / n, 100 * bf.estimatedFpr(),
+           missed);
+
+    // żֱ𽨹ٺϲӦһԼȫλͬ
+    BloomFilter even(n, p), odd(n, p);
+    for (Rank i = 0; i < n; i++) (i % 2 ? odd : even).add((unsigned long long)i);
+    even |= odd;
+    bool same = true;
+    const BitWord* x = even.bits().words();
+    const BitWord* y = bf.bits().words();
+    for (Rank w = 0; same && w < bf.bits().wordCount(); w++) same = (x[w] == y[w]);
+    printf("ϲ룺彨Ĺ%s\n", same ? "һ" : "һ");
+
+    // ȫɾǰһ
+    CountingBloomFilter cbf(n, p);
+    for (Rank i = 0; i < n; i++) cbf.add((unsigned long long)i);
+    for (Rank i = 0; i < n / 2; i++) cbf.remove((unsigned long long)i);
+    Rank cMissed = 0, cRemoved = 0, cFp = 0;
+    for (Rank i = n / 2; i < n; i++) cMissed += !cbf.test((unsigned long long)i);
+    for (Rank i = 0; i < n / 2; i++) cRemoved += cbf.test((unsigned long long)i);
+    for (Rank i = n; i < 2 * n; i++) cFp += cbf.test((unsigned long long)i);
+    printf("%d4λk=%dɾһ© %d ɾԱ %.3f%% %.3f%%\n",
+           cbf.counterCount(), cbf.hashCount(), cMissed, 200.0 * cRemoved / n, 100.0 * cFp / n);
+}
+
+#endif // BLOOM_FILTER_H
@@ -0,0 +1,342 @@
+#ifndef HUFFCODEC_H
+#define HUFFCODEC_H
+
+#include "HuffTree.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <vector>
+
+// ȫֽڣ256ţķֿHuffmanѹ
+// 밴飨Ĭ1MBȡÿ鵥ͳƵʡڴռֻСйأɴļ
+// 볤HUFF_MAX_LENڣʱƵʼؽù淶Huffman룬
+// 볤Ψһȷ˿ͷֻ豣256볤
+// ļʽΪС32λ
+//   "HUF1"
+//   ÿ飺ԭʼֽ>0HUFF_MAX_BLOCK128ֽ볤ÿ4λ4λǰѹֽѹ
+//   ԭʼֽ0
+// ѹݰֽڴӸλλδ֣һֽڲĲֲ0
+
+const int HUFF_MAX_LEN = 15;      // 볤볤ܷŽ4λHUFF_CODE_BITS
+const int HUFF_SYMBOLS = 256;
+const unsigned int HUFF_MAX_BLOCK = 1 << 24;  // ʽ飨ԭʼֽѹʱݴڴ
+
+// Ƶ볤HuffmanȡҶȣ볬maxLenʱƵʼ루ٱ1ٽ
+inline void huffLimitedLengths(const int* freq, int* len, int maxLen = HUFF_MAX_LEN) {
+    std::vector<int> f(freq, freq + HUFF_SYMBOLS);
+    while (true) {
+        HuffTree tree(&f[0], HUFF_SYMBOLS, 0);
+        huffCodeLengths(tree, len, HUFF_SYMBOLS, 0);
+        int longest = 0;
+        for (int i = 0; i < HUFF_SYMBOLS; i++) longest = len[i] > longest ? len[i] : longest;
+        if (longest <= maxLen) return;
+        for (int i = 0; i < HUFF_SYMBOLS; i++) {
+            if (f[i] > 0) f[i] = (f[i] + 1) / 2;
+        }
+    }
+}
+
+// λдִӸλλλ64λۼܹ32λʱһд4ֽ
+class HuffBitWriter {
+private:
+    std::vector<unsigned char>& _out;
+    unsigned long long _acc;  // δдλ_nλЧ_n < 32
+    int _n;
+
+public:
+    HuffBitWriter(std::vector<unsigned char>& out) : _out(out), _acc(0), _n(0) {}
+
+    // дֵĵlenλlen <= 32
+    void put(unsigned int code, int len) {
+        _acc = (_acc << len) | code;
+        _n += len;
+        if (_n >= 32) {
+            _n -= 32;
+            unsigned int x = static_cast<unsigned int>(_acc >> _n);
+            unsigned char b[4] = {static_cast<unsigned char>(x >> 24), static_cast<unsigned char>(x >> 16),
+                                  static_cast<unsigned char>(x >> 8), static_cast<unsigned char>(x)};
+            _out.insert(_out.end(), b, b + 4);
+        }
+    }
+
+    // дʣλһֽڲ8λʱ0
+    void flush() {
+        while (_n >= 8) {
+            _n -= 8;
+            _out.push_back(static_cast<unsigned char>(_acc >> _n));
+        }
+        if (_n > 0) _out.push_back(static_cast<unsigned char>(_acc << (8 - _n)));
+        _n = 0;
+    }
+};
+
+inline void huffPutU32(std::vector<unsigned char>& v, unsigned int x) {
+    for (int i = 0; i < 4; i++) v.push_back(static_cast<unsigned char>(x >> (8 * i)));
+}
+
+inline bool huffGetU32(FILE* in, unsigned int& x) {
+    unsigned char b[4];
+    if (fread(b, 1, 4, in) != 4) return false;
+    x = b[0] | (b[1] << 8) | (b[2] << 16) | ((unsigned int)b[3] << 24);
+    return true;
+}
+
+// ͷе볤ÿֽţ4λǰ
+inline void huffUnpackLengths(const unsigned char* lens, int* len) {
+    for (int i = 0; i < HUFF_SYMBOLS; i += 2) {
+        len[i] = lens[i / 2] >> 4;
+        len[i + 1] = lens[i / 2] & 15;
+    }
+}
+
+// ѹһ飺дͷѹ
+inline void huffCompressBlock(const unsigned char* data, size_t n, std::vector<unsigned char>& out) {
+    int freq[HUFF_SYMBOLS] = {0};
+    for (size_t i = 0; i < n; i++) freq[data[i]]++;
+    int len[HUFF_SYMBOLS];
+    unsigned int code[HUFF_SYMBOLS];
+    huffLimitedLengths(freq, len);
+    huffCanonicalCodes(len, HUFF_SYMBOLS, code);
+
+    huffPutU32(out, (unsigned int)n);
+    for (int i = 0; i < HUFF_SYMBOLS; i += 2) out.push_back(static_cast<unsigned char>(len[i] << 4 | len[i + 1]));
+    size_t sizePos = out.size();
+    huffPutU32(out, 0);  // ѹֽд
+    size_t start = out.size();
+    HuffBitWriter w(out);
+    for (size_t i = 0; i < n; i++) w.put(code[data[i]], len[data[i]]);
+    w.flush();
+    unsigned int packed = (unsigned int)(out.size() - start);
+    for (int i = 0; i < 4; i++) out[sizePos + i] = static_cast<unsigned char>(packed >> (8 * i));
+}
+
+// ѹinļβдoutraw/packedǿʱֽ
+inline bool huffCompress(FILE* in, FILE* out, size_t blockSize = 1 << 20,
+                         unsigned long long* raw = NULL, unsigned long long* packed = NULL) {
+    if (blockSize == 0 || blockSize > HUFF_MAX_BLOCK) {
+        fprintf(stderr, "Error: Invalid block size.\n");
+        return false;
+    }
+    std::vector<unsigned char> buf(blockSize), enc;
+    enc.reserve(blockSize + blockSize / 8 + 256);
+    unsigned long long nIn = 0, nOut = 4;
+    if (fwrite("HUF1", 1, 4, out) != 4) {
+        fprintf(stderr, "Error: Failed to write output.\n");
+        return false;
+    }
+    size_t n;
+    while ((n = fread(&buf[0], 1, blockSize, in)) > 0) {
+        enc.clear();
+        huffCompressBlock(&buf[0], n, enc);
+        if (fwrite(&enc[0], 1, enc.size(), out) != enc.size()) {
+            fprintf(stderr, "Error: Failed to write output.\n");
+            return false;
+        }
+        nIn += n;
+        nOut += enc.size();
+    }
+    enc.clear();
+    huffPutU32(enc, 0);
+    if (ferror(in) || fwrite(&enc[0], 1, 4, out) != 4) {
+        fprintf(stderr, "Error: Failed to read input or write output.\n");
+        return false;
+    }
+    if (raw != NULL) *raw = nIn;
+    if (packed != NULL) *packed = nOut + 4;
+    return true;
+}
+
+// ѹȡhuffCompressдout
+inline bool huffDecompress(FILE* in, FILE* out, unsigned long long* raw = NULL) {
+    char magic[4];
+    if (fread(magic, 1, 4, in) != 4 || memcmp(magic, "HUF1", 4) != 0) {
+        fprintf(stderr, "Error: Not a Huffman-compressed file.\n");
+        return false;
+    }
+    std::vector<unsigned char> packedBuf, rawBuf;
+    unsigned long long nOut = 0;
+    unsigned int n;
+    while (true) {
+        if (!huffGetU32(in, n)) {
+            fprintf(stderr, "Error: Truncated input.\n");
+            return false;
+        }
+        if (n == 0) break;
+        unsigned char lens[HUFF_SYMBOLS / 2];
+        unsigned int packed;
+        if (fread(lens, 1, sizeof(lens), in) != sizeof(lens) || !huffGetU32(in, packed)) {
+            fprintf(stderr, "Error: Truncated block header.\n");
+            return false;
+        }
+        // ͷļʹǰȼ飺СHUFF_MAX_BLOCKÿŵ볤1HUFF_MAX_LENλ֮䣬
+        // ѹֽ(n+7)/8(HUFF_MAX_LEN*n+7)/8֮
+        if (n > HUFF_MAX_BLOCK || packed < (n + 7) / 8 || packed > (HUFF_MAX_LEN * (size_t)n + 7) / 8) {
+            fprintf(stderr, "Error: Corrupt block header.\n");
+            return false;
+        }
+        int len[HUFF_SYMBOLS];
+        huffUnpackLengths(lens, len);
+        // ѹݷֶζ룬ʵʶֽͷƵĳһη
+        size_t got = 0;
+        while (got < packed) {
+            size_t step = packed - got < (1 << 16) ? packed - got : (1 << 16);
+            packedBuf.resize(got + step + 1);
+            if (fread(&packedBuf[got], 1, step, in) != step) {
+                fprintf(stderr, "Error: Truncated block data.\n");
+                return false;
+            }
+            got += step;
+        }
+        rawBuf.resize(n);  // ѹѶȫnλҲHUFF_MAX_BLOCK
+        HuffDecoder dec(len, HUFF_SYMBOLS);
+        if (dec.decode(&packedBuf[0], 8 * (size_t)packed, &rawBuf[0], n) != n) {
+            fprintf(stderr, "Error: Corrupt block data.\n");
+            return false;
+        }
+        if (fwrite(&rawBuf[0], 1, n, out) != n) {
+            fprintf(stderr, "Error: Failed to write output.\n");
+            return false;
+        }
+        nOut += n;
+    }
+    if (raw != NULL) *raw = nOut;
+    return true;
+}
+
+// ļѹ/ѹӡСѹٶ
+inline bool huffFile(const char* src, const char* dst, bool compress) {
+    FILE* in = fopen(src, "rb");
+    if (in == NULL) {
+        fprintf(stderr, "Error: Cannot open %s.\n", src);
+        return false;
+    }
+    FILE* out = fopen(dst, "wb");
+    if (out == NULL) {
+        fprintf(stderr, "Error: Cannot create %s.\n", dst);
+        fclose(in);
+        return false;
+    }
+    unsigned long long raw = 0, packed = 0;
+    clock_t t0 = clock();
+    bool ok = compress ? huffCompress(in, out, 1 << 20, &raw, &packed) : huffDecompress(in, out, &raw);
+    double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    fclose(in);
+    if (fclose(out) != 0) ok = false;
+    if (ok) {
+        if (!compress) {
+            FILE* f = fopen(src, "rb");
+            fseek(f, 0, SEEK_END);
+            packed = ftell(f);
+            fclose(f);
+        }
+        printf("%s%lluֽ -> %lluֽڣѹ %.2f%%%.1f MB/s\n", compress ? "ѹ" : "ѹ",
+               compress ? raw : packed, compress ? packed : raw, raw ? 100.0 * packed / raw : 0.0,
+               raw / (sec > 0 ? sec : 1e-9) / 1e6);
+    }
+    return ok;
+}
+
+// ɲݣZipfֲrֽڳָԼ1/rȣȡֽڣӳΪɶַ
+inline void huffSampleData(std::vector<unsigned char>& v, size_t n, unsigned int seed) {
+    double cdf[HUFF_SYMBOLS], s = 0;
+    for (int r = 0; r < HUFF_SYMBOLS; r++) cdf[r] = (s += 1.0 / (r + 1));
+    unsigned char sym[HUFF_SYMBOLS];
+    const char* common = " etaoinshrdlucmfwypvbgkjqxz\nETAOINSHRDLUCMFWYPVBGKJQXZ.,0123456789";
+    int k = 0;
+    for (; common[k]; k++) sym[k] = static_cast<unsigned char>(common[k]);
+    for (int c = 0; c < HUFF_SYMBOLS; c++) {
+        if (strchr(common, c) == NULL || c == 0) sym[k++] = static_cast<unsigned char>(c);
+    }
+    v.resize(n);
+    srand(seed);
+    for (size_t i = 0; i < n; i++) {
+        double x = (double)(((long long)rand() * RAND_MAX + rand()) % 1000000007) / 1000000007 * s;
+        int lo = 0, hi = HUFF_SYMBOLS - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < x) lo = mid + 1;
+            else hi = mid;
+        }
+        v[i] = sym[lo];
+    }
+}
+
+// ܲԣѹѹһļУ
+inline void benchHuffCodec(size_t n = 32 << 20) {
+    printf("\n=== Huffmanļѹ%luֽڣ ===\n", (unsigned long)n);
+    std::vector<unsigned char> data, back;
+    huffSampleData(data, n, 29);
+    const char* src = "huff_bench.in";
+    const char* packed = "huff_bench.huf";
+    const char* dst = "huff_bench.out";
+    FILE* f = fopen(src, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "Error: Cannot create %s.\n", src);
+        return;
+    }
+    fwrite(&data[0], 1, n, f);
+    fclose(f);
+
+    bool ok = huffFile(src, packed, true) && huffFile(packed, dst, false);
+    if (ok) {
+        f = fopen(dst, "rb");
+        back.resize(n + 1);
+        ok = (f != NULL && fread(&back[0], 1, n + 1, f) == n && memcmp(&back[0], &data[0], n) == 0);
+        if (f != NULL) fclose(f);
+    }
+    printf("%s\n", ok ? "һ" : "һ");
+
+    // ڴзһ飨ļдٶ
+    size_t m = n < (1 << 20) ? n : (1 << 20);
+    std::vector<unsigned char> blk, raw(m + 1);
+    huffCompressBlock(&data[0], m, blk);
+    int len[HUFF_SYMBOLS];
+    huffUnpackLengths(&blk[4], len);
+    HuffDecoder dec(len, HUFF_SYMBOLS);
+    size_t head = 4 + HUFF_SYMBOLS / 2 + 4;
+    int reps = 50;
+    bool same = true;
+    clock_t t0 = clock();
+    for (int r = 0; r < reps; r++) same = (dec.decode(&blk[head], 8 * (blk.size() - head), &raw[0], m) == m) && same;
+    double sec = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    same = same && memcmp(&raw[0], &data[0], m) == 0;
+    printf("ڴ룺%.1f MB/sÿβ%dλ%s\n", reps * m / (sec > 0 ? sec : 1e-9) / 1e6,
+           (int)HuffDecoder::TABLE_BITS, same ? "һ" : "һ");
+
+    // 𻵵ĿͷӦܾҲеĳȷڴ棺Сޣѹֽ볤ķΧ
+    // ֵڷΧ֮ڵݲ㣨ֻʵʶĲ֣
+    const unsigned int bad[][2] = {{0xFFFFFFFFu, 16},
+                                   {16, 0xFFFFFFFFu},
+                                   {0x7FFFFFFF, 0xEFFFFFFFu},
+                                   {0x7FFFFFFF, 0},
+                                   {HUFF_MAX_BLOCK + 1, HUFF_MAX_BLOCK},
+                                   {16, 1},
+                                   {16, 31},
+                                   {HUFF_MAX_BLOCK, (HUFF_MAX_LEN * HUFF_MAX_BLOCK + 7) / 8},
+                                   {HUFF_MAX_BLOCK, HUFF_MAX_BLOCK / 8}};
+    const int nBad = sizeof(bad) / sizeof(bad[0]);
+    int rejected = 0;
+    for (int i = 0; i < nBad; i++) {
+        std::vector<unsigned char> hdr(4);
+        memcpy(&hdr[0], "HUF1", 4);
+        huffPutU32(hdr, bad[i][0]);
+        hdr.insert(hdr.end(), HUFF_SYMBOLS / 2, 0x88);  // ÿ볤8
+        huffPutU32(hdr, bad[i][1]);
+        hdr.resize(hdr.size() + 64, 0);  // ݣͷƵĳ
+        f = fopen(packed, "wb");
+        if (f == NULL) break;
+        fwrite(&hdr[0], 1, hdr.size(), f);
+        fclose(f);
+        FILE* in = fopen(packed, "rb");
+        FILE* out = fopen(dst, "wb");
+        if (in != NULL && out != NULL && !huffDecompress(in, out)) rejected++;
+        if (in != NULL) fclose(in);
+        if (out != NULL) fclose(out);
+    }
+    printf("𻵿ͷ%d/%d ܾ\n", rejected, nBad);
+    remove(src);
+    remove(packed);
+    remove(dst);
+}
+
+#endif // HUFFCODEC_H
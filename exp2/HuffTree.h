@@ -4,6 +4,7 @@
 #include "BinTree.h"   // ͷļ
 #include "Bitmap.h"   // λͼͷļ
 #include <vector>
+#include <string>
 #include <algorithm>
 #include <cctype>     // tolower
 #include <cstddef>    // NULL
@@ -27,13 +28,24 @@ public:
 class HuffTree : public BinTree<std::pair<char, int> > {
 public:
     // 캯26ĸƵ飬Huffman
-    HuffTree(int freq[26]) {
+    // arenaǿʱнڵarenaз
+    HuffTree(int freq[26], Arena* arena = NULL) : BinTree<std::pair<char, int> >(arena) {
+        build(freq, 26, 'a');
+    }
+
+    // 캯nŵƵʣiŶӦַbase + iȫֵֽn = 256base = 0
+    HuffTree(const int* freq, int n, int base, Arena* arena = NULL) : BinTree<std::pair<char, int> >(arena) {
+        build(freq, n, base);
+    }
+
+private:
+    void build(const int* freq, int n, int base) {
         // 1. ȶУСѣӳַֹƵ>0
         std::vector<HuffNode*> heap;
-        for (int i = 0; i < 26; i++) {
+        for (int i = 0; i < n; i++) {
             if (freq[i] > 0) {
-                char c = 'a' + i; // ӳ0-25ĸa-z
-                heap.push_back(new HuffNode(c, freq[i]));
+                char c = static_cast<char>(base + i); // ӳַ
+                heap.push_back(createNode(HuffNode(c, freq[i])));
             }
         }
         // ʼС
@@ -53,7 +65,7 @@ public:
 
             // ڲڵ㣨ȨΪڵ֮ͣ
             int parentFreq = left->data.second + right->data.second;
-            HuffNode* parent = new HuffNode(parentFreq);
+            HuffNode* parent = createNode(HuffNode(parentFreq));
             parent->left = left;  // ӽڵΪȨؽСĽڵ
             parent->right = right; // ӽڵΪȨؽϴĽڵ
 
@@ -69,101 +81,328 @@ public:
     }
 };
 
-// Huffman빤ࣨBitmap洢룩
+// ݹҶ
+inline void huffDepth(const BinNode<std::pair<char, int> >* node, int d, int* len, int n, int base) {
+    if (node == NULL) return;
+    if (node->left == NULL && node->right == NULL) {
+        int idx = static_cast<unsigned char>(node->data.first) - base;
+        if (idx >= 0 && idx < n) len[idx] = d > 0 ? d : 1; // ֻһʱҶӣ볤ȼΪ1
+        return;
+    }
+    huffDepth(node->left, d + 1, len, n, base);
+    huffDepth(node->right, d + 1, len, n, base);
+}
+
+// Huffmanŵı볤ȣҶȣlen[i]Ӧַbase + iδֵķΪ0
+inline void huffCodeLengths(const HuffTree& tree, int* len, int n, int base) {
+    for (int i = 0; i < n; i++) len[i] = 0;
+    huffDepth(tree.getRoot(), 0, len, n, base);
+}
+
+// 淶Huffman룺볤֣ͬһ볤ְ˳ϳڽ϶֮Ʋ0
+// ֻȡ볤˴洢ʱֻ豣ŵ볤
+// code[i]Ϊiŵ֣len[i]λЧlen[i]Ϊ0ķû֣볤HUFF_CODE_BITS
+const int HUFF_CODE_BITS = 32;
+
+inline void huffCanonicalCodes(const int* len, int n, unsigned int* code) {
+    int count[HUFF_CODE_BITS + 1] = {0};
+    unsigned int next[HUFF_CODE_BITS + 1];
+    for (int i = 0; i < n; i++) count[len[i]]++;
+    count[0] = 0;
+    unsigned int c = 0;
+    for (int l = 1; l <= HUFF_CODE_BITS; l++) {
+        c = (c + count[l - 1]) << 1;
+        next[l] = c;
+    }
+    for (int i = 0; i < n; i++) code[i] = len[i] > 0 ? next[len[i]]++ : 0;
+}
+
+// Huffman빤ࣺ볤ȡHuffmanְ淶Huffman
+// ÿĸӳȴƽ̹ıУʱλ64λۼһдһ
 class HuffEncoder {
 private:
-    Bitmap huffCode[26]; // 26ĸı루ÿĸӦһBitmap
-    int codeLen[26];     // ÿĸĳȣ
-
-    // ݹHuffmanɱ루01
-    void generateCode(HuffNode* node, Bitmap& tempCode, int len) {
-        if (node == NULL) return;
-
-        // Ҷӽڵ㣺浱ǰַı
-        if (node->left == NULL && node->right == NULL) {
-            char c = node->data.first;
-            int idx = c - 'a'; // ӳĸ0-25
-            // ʱ뵽ĿBitmap
-            for (int i = 0; i < len; i++) {
-                if (tempCode.test(i)) {
-                    huffCode[idx].set(i);
-                } else {
-                    huffCode[idx].clear(i);
-                }
+    unsigned int huffCode[26]; // 26ĸ֣codeLenλЧ
+    int codeLen[26];           // ÿĸĳȣ
+
+    // ĸתСдĸ-1
+    static int index(char c) {
+        int idx = tolower(static_cast<unsigned char>(c)) - 'a';
+        return (idx < 0 || idx >= 26) ? -1 : idx;
+    }
+
+public:
+    // 캯HuffmanҶȵõ볤ٷ淶
+    HuffEncoder(HuffTree& tree) {
+        huffCodeLengths(tree, codeLen, 26, 'a');
+        huffCanonicalCodes(codeLen, 26, huffCode);
+    }
+
+    // ӿڣѵʱ뵽outУBitmapλУBitmapView鿴رλ
+    // ԷĸַдתСд
+    int encode(const char* word, std::vector<BitWord>& out) const {
+        out.clear();
+        BitWord acc = 0; // ۼnλδдı
+        int n = 0, total = 0;
+        for (int i = 0; word[i] != '\0'; i++) {
+            int idx = index(word[i]);
+            if (idx < 0) continue;
+            int len = codeLen[idx];
+            BitWord code = huffCode[idx];
+            total += len;
+            if (n + len < 64) {
+                acc = (acc << len) | code;
+                n += len;
+            } else {  // ۼдλֲǰдµλۼ
+                int r = 64 - n, rest = len - r;
+                out.push_back(bitmapOrder((acc << r) | (code >> rest)));
+                acc = code & ((1ULL << rest) - 1);
+                n = rest;
             }
-            codeLen[idx] = len; // ¼볤
-            return;
         }
+        if (n > 0) out.push_back(bitmapOrder(acc << (64 - n)));
+        return total;
+    }
+
+    // ӿڣԵʽб룬رַⲿͷڴ棩
+    char* encodeWord(const char* word) const {
+        if (word == NULL) return NULL;
+        std::vector<BitWord> words;
+        int totalLen = encode(word, words);
+        BitmapView v(words.empty() ? NULL : &words[0], (Rank)words.size());
+        return v.bits2string(totalLen);
+    }
+
+    // ӿڣiĸ0Ӧ'a'볤
+    unsigned int code(int i) const {
+        return huffCode[i];
+    }
 
-        // ǰλΪ0
-        tempCode.clear(len);
-        generateCode(static_cast<HuffNode*>(node->left), tempCode, len + 1);
+    int length(int i) const {
+        return codeLen[i];
+    }
 
-        // ǰλΪ1
-        tempCode.set(len);
-        generateCode(static_cast<HuffNode*>(node->right), tempCode, len + 1);
+    // ӿڣӡַı루ڵ֤
+    void printCharCode(char c) const {
+        int idx = index(c);
+        if (idx < 0) {
+            printf("Чַ%c\n", c);
+            return;
+        }
+        char code[HUFF_CODE_BITS + 1];
+        int len = codeLen[idx];
+        for (int j = 0; j < len; j++) code[j] = ((huffCode[idx] >> (len - 1 - j)) & 1) ? '1' : '0';
+        code[len] = '\0';
+        printf("%c ı룺%sȣ%d أ\n", tolower(static_cast<unsigned char>(c)), code, len);
     }
+};
 
+// Huffman淶룩
+// һұԽTABLE_BITSλΪ±꣬һβ1~2ţ
+// 볤TABLE_BITS֣¶TABLE_BITSλڵĽڵ㣬λ²֡
+// ΪֽڴӸλλеλHuffEncoder::encodeĽBitmapλУHuffCodecѹݶָʽ
+class HuffDecoder {
 public:
-    // 캯Huffmanĸı
-    HuffEncoder(HuffTree& tree) {
-        // ʼcodeLenΪ0
-        for (int i = 0; i < 26; i++) {
-            codeLen[i] = 0;
+    enum { TABLE_BITS = 11 };
+
+private:
+    struct Entry {
+        unsigned char sym[2];  // ķţʱ_base
+        unsigned char n;       // ķ0ʾЧǰ׺
+        unsigned char len0;    // һŵ볤
+        unsigned char bits;    // nŵ볤
+        unsigned short node;   // nΪ0ʱTABLE_BITSλڵڵ㣨0ʾЧǰ׺
+    };
+
+    std::vector<Entry> _table;
+    std::vector<int> _child;   // ڵiΪ_child[2i]_child[2i+1]0ʾޣ>0Ϊڲڵ㣬<0ΪҶ-(+1)
+    int _base;
+
+    // ڽв
+    void insert(unsigned int code, int len, int sym) {
+        int node = 0;
+        for (int j = len - 1; j >= 0; j--) {
+            int b = (code >> j) & 1;
+            if (j == 0) {
+                _child[2 * node + b] = -(sym + 1);
+            } else {
+                if (_child[2 * node + b] <= 0) {
+                    _child[2 * node + b] = (int)_child.size() / 2;
+                    _child.push_back(0);
+                    _child.push_back(0);
+                }
+                node = _child[2 * node + b];
+            }
         }
-        
-        Bitmap tempCode; // ʱ洢ǰ·ı
-        generateCode(static_cast<HuffNode*>(tree.getRoot()), tempCode, 0);
     }
 
-    // ӿڣԵʽб루ԷĸַԶתСд
-    char* encodeWord(const char* word) {
-        if (word == NULL) return NULL;
+    // ӽڵnodexĸλbitsλߣҶӷطŲõλڲ-1Ч-2
+    int walk(unsigned int x, int bits, int& node, int& used) const {
+        node = 0;
+        for (used = 0; used < bits;) {
+            int c = _child[2 * node + ((x >> (bits - 1 - used)) & 1)];
+            used++;
+            if (c == 0) return -2;
+            if (c < 0) return -c - 1;
+            node = c;
+        }
+        return -1;
+    }
 
-        // 1. ܳȣۼÿĸı볤ȣ
-        int totalLen = 0;
-        for (int i = 0; word[i] != '\0'; i++) {
-            char c = static_cast<char>(tolower(static_cast<unsigned char>(word[i]))); // תΪСд
-            int idx = c - 'a';
-            if (idx < 0 || idx >= 26) continue; // ĸַ
-            totalLen += codeLen[idx];
+    void build(const int* len, int n) {
+        std::vector<unsigned int> code(n);
+        huffCanonicalCodes(len, n, &code[0]);
+        _child.assign(2, 0);
+        for (int i = 0; i < n; i++) {
+            if (len[i] > 0) insert(code[i], len[i], i);
+        }
+        _table.resize(1 << TABLE_BITS);
+        for (unsigned int x = 0; x < (1u << TABLE_BITS); x++) {
+            Entry& e = _table[x];
+            e.sym[0] = e.sym[1] = e.n = e.len0 = e.bits = 0;
+            e.node = 0;
+            int node, used;
+            int s = walk(x, TABLE_BITS, node, used);
+            if (s < 0) {
+                if (s == -1) e.node = (unsigned short)node;
+                continue;
+            }
+            e.sym[0] = (unsigned char)s;
+            e.n = 1;
+            e.len0 = e.bits = (unsigned char)used;
+            // ʣλܷٽһķ
+            int rest = TABLE_BITS - used, used2;
+            if (rest > 0) {
+                int s2 = walk(x & ((1u << rest) - 1), rest, node, used2);
+                if (s2 >= 0) {
+                    e.sym[1] = (unsigned char)s2;
+                    e.n = 2;
+                    e.bits = (unsigned char)(used + used2);
+                }
+            }
         }
+    }
 
-        // 2. ϲĸı뵽һBitmap
-        Bitmap totalCode(totalLen);
-        int pos = 0; // ǰдλãأ
-        for (int i = 0; word[i] != '\0'; i++) {
-            char c = static_cast<char>(tolower(static_cast<unsigned char>(word[i])));
-            int idx = c - 'a';
-            if (idx < 0 || idx >= 26) continue;
-
-            // Ƶǰĸı뵽ܱ
-            for (int j = 0; j < codeLen[idx]; j++) {
-                if (huffCode[idx].test(j)) {
-                    totalCode.set(pos + j);
+    // 룺ӽڵnodebufеTABLE_BITSλλߣõvalidλطţЧݲ㷵-1
+    int longCode(unsigned long long buf, int valid, int node, int& used) const {
+        for (used = TABLE_BITS; used < valid;) {
+            int c = _child[2 * node + ((buf >> (63 - used)) & 1)];
+            used++;
+            if (c == 0) return -1;
+            if (c < 0) return -c - 1;
+            node = c;
+        }
+        return -1;
+    }
+
+public:
+    // nŵ볤죨huffCanonicalCodesһ£iΪַbase + i
+    HuffDecoder(const int* len, int n, int base = 0) : _base(base) {
+        build(len, n);
+    }
+
+    // HuffEncoder
+    HuffDecoder(const HuffEncoder& enc) : _base('a') {
+        int len[26];
+        for (int i = 0; i < 26; i++) len[i] = enc.length(i);
+        build(len, 26);
+    }
+
+public:
+    // inbitsλнnдoutʵʽĸЧֻʱǰֹͣ
+    size_t decode(const unsigned char* in, size_t bits, unsigned char* out, size_t n) const {
+        size_t bytes = (bits + 7) / 8, pos = 0;  // posһҪ뻺ֽ
+        unsigned long long buf = 0;  // λcntλδλ
+        int cnt = 0, used;
+        size_t k = 0;
+        // ·ĩβ8ֽʱֲ仺壨λȫЧ
+        // ֻ֮Ҫлһ־ÿдŵλáǰe.n
+        while (pos + 8 <= bytes && k + 2 <= n) {
+            BitWord w;
+            memcpy(&w, in + pos, 8);
+            buf |= bitmapOrder(w) >> cnt;
+            pos += (63 - cnt) >> 3;
+            cnt |= 56;
+            while (cnt >= HUFF_CODE_BITS && k + 2 <= n) {
+                const Entry& e = _table[buf >> (64 - TABLE_BITS)];
+                if (e.n != 0) {
+                    out[k] = (unsigned char)(_base + e.sym[0]);
+                    out[k + 1] = (unsigned char)(_base + e.sym[1]);
+                    k += e.n;
+                    buf <<= e.bits;
+                    cnt -= e.bits;
                 } else {
-                    totalCode.clear(pos + j);
+                    int s = e.node != 0 ? longCode(buf, cnt, e.node, used) : -1;
+                    if (s < 0) return k;
+                    out[k++] = (unsigned char)(_base + s);
+                    buf <<= used;
+                    cnt -= used;
                 }
             }
-            pos += codeLen[idx];
         }
+        // ĩβֽڲ䣬ֻʹλĩֽڲ0㣩
+        long long remain = (long long)bits - 8 * (long long)pos;  // δ뻺Чλ
+        while (k < n) {
+            while (cnt <= 56 && pos < bytes) {
+                buf |= (unsigned long long)in[pos++] << (56 - cnt);
+                cnt += 8;
+                remain -= 8;
+            }
+            int valid = remain < 0 ? cnt + (int)remain : cnt;
+            const Entry& e = _table[buf >> (64 - TABLE_BITS)];
+            if (e.n == 2 && e.bits <= valid && k + 1 < n) {
+                out[k++] = (unsigned char)(_base + e.sym[0]);
+                out[k++] = (unsigned char)(_base + e.sym[1]);
+                buf <<= e.bits;
+                cnt -= e.bits;
+            } else if (e.n >= 1 && e.len0 <= valid) {
+                out[k++] = (unsigned char)(_base + e.sym[0]);
+                buf <<= e.len0;
+                cnt -= e.len0;
+            } else {
+                int s = (e.n == 0 && e.node != 0) ? longCode(buf, valid, e.node, used) : -1;
+                if (s < 0) break;  // Чֻ
+                out[k++] = (unsigned char)(_base + s);
+                buf <<= used;
+                cnt -= used;
+            }
+        }
+        return k;
+    }
 
-        // 3. BitmapתΪַأⲿͷڴ棩
-        return totalCode.bits2string(totalLen);
+    // HuffEncoder::encodebitsλؽĵ
+    std::string decodeWord(const std::vector<BitWord>& words, int bits) const {
+        std::string s(bits, '\0');  // ÿ1λ
+        size_t k = words.empty() ? 0 : decode(reinterpret_cast<const unsigned char*>(&words[0]), bits,
+                                                reinterpret_cast<unsigned char*>(&s[0]), s.size());
+        s.resize(k);
+        return s;
     }
+};
 
-    // ӿڣӡַı루ڵ֤
-    void printCharCode(char c) {
-        c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
-        int idx = c - 'a';
-        if (idx < 0 || idx >= 26) {
-            printf("Чַ%c\n", c);
-            return;
+// ԣƵʣɳƫбֲʾHuffEncoderHuffDecoder룬ӦԭʣСдһ
+inline bool testHuffDecoder(int rounds = 300) {
+    srand(31);
+    for (int t = 0; t < rounds; t++) {
+        int freq[26];
+        for (int i = 0; i < 26; i++) {
+            freq[i] = (t % 3 == 0) ? (1 << (i % 24)) : rand() % 1000 + (rand() % 4 != 0);
         }
-        char* code = huffCode[idx].bits2string(codeLen[idx]);
-        printf("%c ı룺%sȣ%d أ\n", c, code, codeLen[idx]);
-        delete[] code; // ͷַڴ
+        HuffTree tree(freq);
+        HuffEncoder enc(tree);
+        HuffDecoder dec(enc);
+        std::string word, expect;
+        int n = rand() % 500;
+        for (int i = 0; i < n; i++) {
+            int idx = rand() % 26;
+            if (freq[idx] == 0) continue;
+            word += (char)((rand() % 4 == 0 ? 'A' : 'a') + idx);
+            expect += (char)('a' + idx);
+        }
+        std::vector<BitWord> words;
+        int bits = enc.encode(word.c_str(), words);
+        if (dec.decodeWord(words, bits) != expect) return false;
     }
-};
+    return true;
+}
 
 #endif // HUFFTREE_H
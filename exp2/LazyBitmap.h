@@ -0,0 +1,157 @@
+#ifndef LAZY_BITMAP_H
+#define LAZY_BITMAP_H
+
+#include <vector>
+#include "Bitmap.h"
+
+// O(1)ʼλͼ̶set/clearԣtestΪ0졢settestclearresetΪO(1)
+// Mʼ¼ЩѱʼУ黷ɣ
+//   wЧҽ F[w] < top  T[F[w]] == w
+// δʼF[w]ֵֻǼǹֲͨTķУ飻Чְȫ0
+// reset()ֻtop㣬ͬʱʧЧʺÿβѯҪһɾϵĳ
+// עüȡδʼڴ棬MemorySanitizerһ๤߻ᱨ棬ԤΪ
+class LazyBitmap {
+private:
+    BitWord* M;   // ֣δʼ
+    Rank* F;      // F[w]wTеĵǼλãδʼ
+    Rank* T;      // T[i]iǼǵֱ
+    Rank N;       // 
+    Rank top;     // ѵǼǵ
+    Rank _sz;     // ֵΪ1λ
+
+    LazyBitmap(const LazyBitmap&);
+    LazyBitmap& operator=(const LazyBitmap&);
+
+    // wǷѳʼ
+    bool valid(Rank w) const {
+        return 0 <= F[w] && F[w] < top && T[F[w]] == w;
+    }
+
+    // ״дw֣㲢Ǽ
+    void touch(Rank w) {
+        if (valid(w)) return;
+        M[w] = 0;
+        F[w] = top;
+        T[top++] = w;
+    }
+
+public:
+    // 죺ֻ䲻ʼO(1)ƲϵͳҳĿ
+    LazyBitmap(Rank n) : top(0), _sz(0) {
+        N = (n + 63) / 64;
+        if (N < 1) N = 1;
+        M = new BitWord[N];
+        F = new Rank[N];
+        T = new Rank[N];
+    }
+
+    ~LazyBitmap() {
+        delete[] M;
+        delete[] F;
+        delete[] T;
+    }
+
+    // ȫλO(1)
+    void reset() {
+        top = 0;
+        _sz = 0;
+    }
+
+    // kλΪ1
+    void set(Rank k) {
+        if (k < 0 || k >= 64 * N) return;
+        Rank w = k >> 6;
+        touch(w);
+        BitWord mask = bitmapMask(k);
+        if (!(M[w] & mask)) {
+            M[w] |= mask;
+            _sz++;
+        }
+    }
+
+    // kλΪ0
+    void clear(Rank k) {
+        if (k < 0 || k >= 64 * N) return;
+        Rank w = k >> 6;
+        if (!valid(w)) return;  // δʼֱȫ0
+        BitWord mask = bitmapMask(k);
+        if (M[w] & mask) {
+            M[w] &= ~mask;
+            _sz--;
+        }
+    }
+
+    // жϵkλǷΪ1
+    bool test(Rank k) const {
+        if (k < 0 || k >= 64 * N) return false;
+        Rank w = k >> 6;
+        return valid(w) && (M[w] & bitmapMask(k)) != 0;
+    }
+
+    // kλΪ1ԭֵ
+    bool testAndSet(Rank k) {
+        bool old = test(k);
+        set(k);
+        return old;
+    }
+
+    Rank size() const {
+        return _sz;
+    }
+
+    Rank capacity() const {
+        return 64 * N;
+    }
+
+    // ÿֵΪ1λkvisit(k)ֻѳʼֵ֣ĳʼȺȵ˳
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (Rank i = 0; i < top; i++) {
+            Rank w = T[i];
+            for (BitWord x = bitmapOrder(M[w]); x != 0; x &= ~(0x8000000000000000ULL >> bitmapClz(x))) {
+                visit(64 * w + bitmapClz(x));
+            }
+        }
+    }
+};
+
+// ܲԣÿβѯʹһɾĴ󼯺ϣԱBitmapO(1)õLazyBitmap
+inline void benchLazyBitmap(Rank n = 1 << 26, int queries = 200, int touches = 1000) {
+    printf("\n=== O(1)ʼλͼ%dλ%dβѯÿ%dλ ===\n", n, queries, touches);
+    std::vector<Rank> keys(queries * touches);
+    srand(19);
+    for (size_t i = 0; i < keys.size(); i++) keys[i] = (Rank)(((long long)rand() * RAND_MAX + rand()) % n);
+
+    // 
+    clock_t t0 = clock();
+    Bitmap* b = new Bitmap(n);
+    double bitmapInit = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    LazyBitmap* lb = new LazyBitmap(n);
+    double lazyInit = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+    // ÿβѯաλۼƼϴС
+    long long sum1 = 0, sum2 = 0;
+    t0 = clock();
+    for (int q = 0; q < queries; q++) {
+        b->clearRange(0, n);
+        for (int i = 0; i < touches; i++) b->set(keys[q * touches + i]);
+        sum1 += b->size();
+    }
+    double bitmapTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    t0 = clock();
+    for (int q = 0; q < queries; q++) {
+        lb->reset();
+        for (int i = 0; i < touches; i++) lb->set(keys[q * touches + i]);
+        sum2 += lb->size();
+    }
+    double lazyTime = (double)(clock() - t0) / CLOCKS_PER_SEC;
+    delete b;
+    delete lb;
+
+    printf("죺Bitmap %.4f 룬LazyBitmap %.6f \n", bitmapInit, lazyInit);
+    printf("ѯBitmap %.3f 룬LazyBitmap %.4f 루%s\n", bitmapTime, lazyTime,
+           sum1 == sum2 ? "һ" : "һ");
+}
+
+#endif // LAZY_BITMAP_H
@@ -0,0 +1,198 @@
+#ifndef PRIME_SIEVE_H
+#define PRIME_SIEVE_H
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include "Bitmap.h"
+
+// ֶβеEratosthenesɸֻɸ
+// [1, limit]еλ֣ÿһsegBitsλBitmapĬ2^18λ32KBԼΪһ/С
+// iλʾölo + 2iΪ1ʾÿֻòsqrt(limit)Ļǣ
+// λɶ߳ȡÿ̸߳Լһλͼ
+// ֵ64λlimitɵ10^10ϣ±Rank
+class PrimeSieve {
+private:
+    unsigned long long _limit;
+    std::vector<unsigned int> _base;  // sqrt(limit)
+    Rank _segBits;                    // ÿελÿθ2*_segBits
+    long long _segs;                  // 
+    int _threads;
+
+    // ռķiλӦlo + 2i
+    struct Collector {
+        std::vector<unsigned long long>* out;
+        unsigned long long lo;
+        Collector(std::vector<unsigned long long>* o, unsigned long long l) : out(o), lo(l) {}
+        void operator()(Rank i) {
+            out->push_back(lo + 2 * (unsigned long long)i);
+        }
+    };
+
+    // ɸsΣظöεЧλɸsegΪ1λǺ1Ҳ
+    Rank sieveSegment(Bitmap& seg, long long s) const {
+        unsigned long long lo = 1 + 2 * (unsigned long long)_segBits * s;
+        Rank bits = _segBits;
+        if ((_limit - lo) / 2 + 1 < (unsigned long long)bits) bits = (Rank)((_limit - lo) / 2 + 1);
+        unsigned long long hi = lo + 2 * (unsigned long long)(bits - 1);  // 
+        seg.clearRange(0, seg.capacity());
+        if (lo == 1) seg.set(0);
+        for (size_t j = 0; j < _base.size(); j++) {
+            unsigned long long p = _base[j];
+            if (p * p > hi) break;
+            // һҪǵ汶Сp*pҲСlo
+            unsigned long long m = p * p;
+            if (m < lo) {
+                m = (lo + p - 1) / p * p;
+                if (m % 2 == 0) m += p;
+            }
+            if (m <= hi) seg.setStride((Rank)((m - lo) / 2), bits, (Rank)p);
+        }
+        return bits;
+    }
+
+    // ̺߳ȡһΣֱs1Σoutǿʱѵsεout[s - s0]ֻ
+    void work(std::atomic<long long>* next, long long s0, long long s1,
+              std::vector<unsigned long long>* out, unsigned long long* cnt) const {
+        Bitmap seg(_segBits);
+        unsigned long long c = 0;
+        for (long long s; (s = next->fetch_add(1)) < s1;) {
+            Rank bits = sieveSegment(seg, s);
+            c += bits - seg.size();
+            if (out != NULL) {
+                seg.flip(bits);  // תΪ1λ
+                Collector visit(&out[s - s0], 1 + 2 * (unsigned long long)_segBits * s);
+                out[s - s0].clear();
+                seg.traverse(visit);
+            }
+        }
+        *cnt = c;
+    }
+
+    // ȫ̴߳[s0, s1)Σĸ
+    unsigned long long run(long long s0, long long s1, std::vector<unsigned long long>* out) const {
+        std::atomic<long long> next(s0);
+        std::vector<unsigned long long> cnt(_threads, 0);
+        std::vector<std::thread> pool;
+        for (int t = 1; t < _threads; t++) {
+            pool.push_back(std::thread(&PrimeSieve::work, this, &next, s0, s1, out, &cnt[t]));
+        }
+        work(&next, s0, s1, out, &cnt[0]);  // ǰ߳Ҳ
+        for (size_t t = 0; t < pool.size(); t++) pool[t].join();
+        unsigned long long c = 0;
+        for (int t = 0; t < _threads; t++) c += cnt[t];
+        return c;
+    }
+
+public:
+    // ɸ[1, limit]threadsΪ0ʱʹӲ߳
+    PrimeSieve(unsigned long long limit, int threads = 0, Rank segBits = 1 << 18)
+        : _limit(limit), _segBits(segBits < 64 ? 64 : segBits), _threads(threads) {
+        if (_threads <= 0) _threads = (int)std::thread::hardware_concurrency();
+        if (_threads <= 0) _threads = 1;
+        _segs = limit < 1 ? 0 : (long long)((limit - 1) / 2 / _segBits + 1);
+        // sqrt(limit)ڵһͨɸiλʾ2i+1
+        unsigned long long r = (unsigned long long)sqrt((double)limit);
+        while (r * r > limit) r--;
+        while ((r + 1) * (r + 1) <= limit) r++;
+        Rank n = (Rank)(r / 2 + 1);
+        Bitmap small(n);
+        for (Rank i = 1; i < n; i++) {
+            if (small.test(i)) continue;
+            unsigned long long p = 2 * i + 1;
+            _base.push_back((unsigned int)p);
+            if (p * p <= r) small.setStride((Rank)(p * p / 2), n, (Rank)p);
+        }
+    }
+
+    unsigned long long limit() const {
+        return _limit;
+    }
+
+    int threads() const {
+        return _threads;
+    }
+
+    // limit
+    unsigned long long count() const {
+        if (_limit < 2) return 0;
+        return 1 + run(0, _segs, NULL);  // 2
+    }
+
+    // С˳ÿpvisit(p)
+    // ÿɸ̲߳ɸbatchβݴٰ˳ʣڴռbatch
+    template <typename VST>
+    void traverse(VST& visit, int batch = 0) const {
+        if (_limit < 2) return;
+        visit(2ULL);
+        if (batch <= 0) batch = 4 * _threads;
+        std::vector<std::vector<unsigned long long> > out(batch);
+        for (long long s0 = 0; s0 < _segs; s0 += batch) {
+            long long s1 = s0 + batch < _segs ? s0 + batch : _segs;
+            run(s0, s1, &out[0]);
+            for (long long s = s0; s < s1; s++) {
+                const std::vector<unsigned long long>& v = out[s - s0];
+                for (size_t i = 0; i < v.size(); i++) visit(v[i]);
+            }
+        }
+    }
+
+    // ȫlimitϴʱռڴܶ࣬ķΧtraverse
+    void primes(std::vector<unsigned long long>& v) const {
+        struct Append {
+            std::vector<unsigned long long>* v;
+            void operator()(unsigned long long p) {
+                v->push_back(p);
+            }
+        } app;
+        app.v = &v;
+        v.clear();
+        traverse(app);
+    }
+};
+
+// ʱͳƸУ
+struct PrimeCounter {
+    unsigned long long n, sum, last;
+    PrimeCounter() : n(0), sum(0), last(0) {}
+    void operator()(unsigned long long p) {
+        n++;
+        sum += p;
+        last = p;
+    }
+};
+
+// ܲԣͬ¼öٵ£֪λͼͨɸ
+inline void benchPrimeSieve() {
+    printf("\n=== Էֶβɸ%ụ߳ ===\n", std::thread::hardware_concurrency());
+    const unsigned long long limits[] = {10000000ULL, 100000000ULL, 1000000000ULL};
+    const unsigned long long known[] = {664579ULL, 5761455ULL, 50847534ULL};
+    for (int i = 0; i < 3; i++) {
+        PrimeSieve ps(limits[i]);
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        unsigned long long c = ps.count();
+        double countTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        t0 = std::chrono::steady_clock::now();
+        PrimeCounter pc;
+        ps.traverse(pc);
+        double listTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        printf("%lluڣ%llu%s %.3f 루%.1f /룩ö %.3f 룬 %llu\n",
+               limits[i], c, c == known[i] && pc.n == c ? "ȷ" : "", countTime, c / countTime / 1e6,
+               listTime, pc.last);
+    }
+
+    // գλͼֻɸͨɸ
+    Rank n = 100000000 / 2;
+    clock_t c0 = clock();
+    Bitmap whole(n);
+    whole.set(0);
+    for (Rank i = 1; (long long)(2 * i + 1) * (2 * i + 1) < 2LL * n; i++) {
+        if (!whole.test(i)) whole.setStride((2 * i + 1) * (2 * i + 1) / 2, n, 2 * i + 1);
+    }
+    Rank c = 1 + n - whole.size();
+    printf("գλͼɸ10^8 %.3f 루%d\n", (double)(clock() - c0) / CLOCKS_PER_SEC, c);
+}
+
+#endif // PRIME_SIEVE_H
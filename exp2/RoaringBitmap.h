@@ -0,0 +1,492 @@
+#ifndef ROARING_BITMAP_H
+#define ROARING_BITMAP_H
+
+#include <vector>
+#include <algorithm>
+#include "Bitmap.h"
+
+// ѹλͼRoaringȿռ䰴16λΪ2^16λһ飬ÿ鰴ѡһ
+//   ĵ16λ飬ʺϡ飨ARRAY_MAXԪأ2ֽ/Ԫأ
+//   λͼ2^16λĳλͼ8KBԪضARRAY_MAXʱʹ
+//   γ[, +]䣬ʺϴĿ飬runOptimize()
+// ֻΪǿյĿڴԪظγ̸ȣȳ
+class RoaringBitmap {
+public:
+    enum { ARRAY_CONTAINER, BITMAP_CONTAINER, RUN_CONTAINER };
+    enum {
+        CHUNK_BITS = 1 << 16,            // ÿλ
+        CHUNK_WORDS = CHUNK_BITS / 64,   // λͼ
+        ARRAY_MAX = 4096                 // Ԫٶλͼʡռ䣩
+    };
+
+private:
+    // һֱʾֻtypeӦһЧ
+    struct Container {
+        int type;
+        int card;                            // Ԫظ
+        std::vector<unsigned short> array;   // ĵ16λ
+        std::vector<BitWord> bits;           // λͼBitmapͬλУ黥ת
+        std::vector<unsigned short> runs;    // γɶԴţ㣬-1
+
+        Container() : type(ARRAY_CONTAINER), card(0) {}
+    };
+
+    std::vector<unsigned short> _keys;   // ǿտıţ16λ
+    std::vector<Container> _cont;        // _keysһһӦ
+
+    // key±ꣻʱ-(λ)-1
+    int findKey(unsigned short key) const {
+        std::vector<unsigned short>::const_iterator it = std::lower_bound(_keys.begin(), _keys.end(), key);
+        int i = (int)(it - _keys.begin());
+        return (it != _keys.end() && *it == key) ? i : -i - 1;
+    }
+
+    // γаvγ±꣬û-1
+    static int findRun(const Container& c, unsigned v) {
+        int lo = 0, hi = (int)c.runs.size() / 2;  // һ <= v γ
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (c.runs[2 * mid] <= v) lo = mid + 1;
+            else hi = mid;
+        }
+        if (lo == 0) return -1;
+        int r = lo - 1;
+        return (v <= (unsigned)c.runs[2 * r] + c.runs[2 * r + 1]) ? r : -1;
+    }
+
+    static bool contains(const Container& c, unsigned v) {
+        switch (c.type) {
+            case ARRAY_CONTAINER:
+                return std::binary_search(c.array.begin(), c.array.end(), (unsigned short)v);
+            case BITMAP_CONTAINER:
+                return (c.bits[v >> 6] & bitmapMask((Rank)v)) != 0;
+            default:
+                return findRun(c, v) >= 0;
+        }
+    }
+
+    // չΪCHUNK_WORDSֵλͼ
+    static void toWords(const Container& c, BitWord* w) {
+        if (c.type == BITMAP_CONTAINER) {
+            std::copy(c.bits.begin(), c.bits.end(), w);
+            return;
+        }
+        std::fill(w, w + CHUNK_WORDS, 0ULL);
+        if (c.type == ARRAY_CONTAINER) {
+            for (size_t i = 0; i < c.array.size(); i++) w[c.array[i] >> 6] |= bitmapMask(c.array[i]);
+        } else {
+            for (size_t r = 0; r < c.runs.size(); r += 2) {
+                unsigned lo = c.runs[r], hi = lo + c.runs[r + 1];
+                for (unsigned v = lo; v <= hi; v++) w[v >> 6] |= bitmapMask((Rank)v);
+            }
+        }
+    }
+
+    // λͼֽԪزARRAY_MAXʱλͼ
+    static void fromWords(Container& c, const BitWord* w) {
+        int card = 0;
+        for (int i = 0; i < CHUNK_WORDS; i++) card += bitmapPopcount(w[i]);
+        c.card = card;
+        std::vector<unsigned short>().swap(c.runs);
+        if (card <= ARRAY_MAX) {
+            c.type = ARRAY_CONTAINER;
+            std::vector<BitWord>().swap(c.bits);
+            c.array.clear();
+            c.array.reserve(card);
+            for (int i = 0; i < CHUNK_WORDS; i++) {
+                for (BitWord x = bitmapOrder(w[i]); x != 0; x &= ~(0x8000000000000000ULL >> bitmapClz(x))) {
+                    c.array.push_back((unsigned short)(64 * i + bitmapClz(x)));
+                }
+            }
+        } else {
+            c.type = BITMAP_CONTAINER;
+            c.array.clear();
+            c.bits.assign(w, w + CHUNK_WORDS);
+        }
+    }
+
+    // γ޸ǰȻԭΪλͼ
+    static void unpackRuns(Container& c) {
+        if (c.type != RUN_CONTAINER) return;
+        std::vector<BitWord> w(CHUNK_WORDS);
+        toWords(c, &w[0]);
+        fromWords(c, &w[0]);
+    }
+
+    // мvǷ¼
+    static bool add(Container& c, unsigned v) {
+        unpackRuns(c);
+        if (c.type == BITMAP_CONTAINER) {
+            BitWord mask = bitmapMask((Rank)v);
+            if (c.bits[v >> 6] & mask) return false;
+            c.bits[v >> 6] |= mask;
+            c.card++;
+            return true;
+        }
+        std::vector<unsigned short>::iterator it = std::lower_bound(c.array.begin(), c.array.end(), (unsigned short)v);
+        if (it != c.array.end() && *it == v) return false;
+        c.array.insert(it, (unsigned short)v);
+        c.card++;
+        if (c.card > ARRAY_MAX) {  // תΪλͼ
+            std::vector<BitWord> w(CHUNK_WORDS);
+            toWords(c, &w[0]);
+            c.type = BITMAP_CONTAINER;
+            c.bits.swap(w);
+            std::vector<unsigned short>().swap(c.array);
+        }
+        return true;
+    }
+
+    // ɾvǷԭ
+    static bool remove(Container& c, unsigned v) {
+        unpackRuns(c);
+        if (c.type == BITMAP_CONTAINER) {
+            BitWord mask = bitmapMask((Rank)v);
+            if (!(c.bits[v >> 6] & mask)) return false;
+            c.bits[v >> 6] &= ~mask;
+            c.card--;
+            if (c.card <= ARRAY_MAX) {  // 㹻ϡ裬ת
+                std::vector<BitWord> w;
+                w.swap(c.bits);
+                fromWords(c, &w[0]);
+            }
+            return true;
+        }
+        std::vector<unsigned short>::iterator it = std::lower_bound(c.array.begin(), c.array.end(), (unsigned short)v);
+        if (it == c.array.end() || *it != v) return false;
+        c.array.erase(it);
+        c.card--;
+        return true;
+    }
+
+    // Ĳ
+    static void unite(const Container& a, const Container& b, Container& out) {
+        if (a.type == ARRAY_CONTAINER && b.type == ARRAY_CONTAINER && a.card + b.card <= ARRAY_MAX) {
+            out.type = ARRAY_CONTAINER;
+            out.array.resize(a.card + b.card);
+            out.array.resize(std::set_union(a.array.begin(), a.array.end(), b.array.begin(), b.array.end(),
+                                            out.array.begin()) - out.array.begin());
+            out.card = (int)out.array.size();
+            return;
+        }
+        std::vector<BitWord> wa(CHUNK_WORDS), wb(CHUNK_WORDS);
+        toWords(a, &wa[0]);
+        toWords(b, &wb[0]);
+        for (int i = 0; i < CHUNK_WORDS; i++) wa[i] |= wb[i];
+        fromWords(out, &wa[0]);
+    }
+
+    // Ľ
+    static void intersect(const Container& a, const Container& b, Container& out) {
+        if (a.type == ARRAY_CONTAINER || b.type == ARRAY_CONTAINER) {
+            const Container& small = (a.type == ARRAY_CONTAINER) ? a : b;
+            const Container& other = (a.type == ARRAY_CONTAINER) ? b : a;
+            out.type = ARRAY_CONTAINER;
+            out.array.clear();
+            for (size_t i = 0; i < small.array.size(); i++) {
+                if (contains(other, small.array[i])) out.array.push_back(small.array[i]);
+            }
+            out.card = (int)out.array.size();
+            return;
+        }
+        std::vector<BitWord> wa(CHUNK_WORDS), wb(CHUNK_WORDS);
+        toWords(a, &wa[0]);
+        toWords(b, &wb[0]);
+        for (int i = 0; i < CHUNK_WORDS; i++) wa[i] &= wb[i];
+        fromWords(out, &wa[0]);
+    }
+
+    // ռõֽ
+    static size_t containerBytes(const Container& c) {
+        return sizeof(Container) + c.array.capacity() * sizeof(unsigned short) +
+               c.bits.capacity() * sizeof(BitWord) + c.runs.capacity() * sizeof(unsigned short);
+    }
+
+public:
+    RoaringBitmap() {}
+
+    // Bitmapת鸴֣ȫ0Ŀ
+    explicit RoaringBitmap(const Bitmap& b) {
+        const BitWord* M = b.words();
+        Rank nW = b.wordCount();
+        std::vector<BitWord> w(CHUNK_WORDS);
+        for (Rank base = 0; base < nW; base += CHUNK_WORDS) {
+            Rank n = std::min((Rank)CHUNK_WORDS, nW - base);
+            bool any = false;
+            for (Rank i = 0; i < n && !any; i++) any = (M[base + i] != 0);
+            if (!any) continue;
+            std::copy(M + base, M + base + n, w.begin());
+            std::fill(w.begin() + n, w.end(), 0ULL);
+            _keys.push_back((unsigned short)(base / CHUNK_WORDS));
+            _cont.push_back(Container());
+            fromWords(_cont.back(), &w[0]);
+        }
+    }
+
+    // תΪBitmap鰴ֲ룬λset
+    void toBitmap(Bitmap& b) const {
+        std::vector<BitWord> w(CHUNK_WORDS);
+        for (size_t i = 0; i < _keys.size(); i++) {
+            toWords(_cont[i], &w[0]);
+            Rank n = CHUNK_WORDS;
+            while (n > 0 && w[n - 1] == 0) n--;  // ȥβȫ0֣ⲻҪ
+            b.mergeWords((Rank)_keys[i] * CHUNK_WORDS, &w[0], n);
+        }
+    }
+
+    // Ԫظ
+    Rank size() const {
+        Rank n = 0;
+        for (size_t i = 0; i < _cont.size(); i++) n += _cont[i].card;
+        return n;
+    }
+
+    bool empty() const {
+        return _keys.empty();
+    }
+
+    // жϵkλǷΪ1
+    bool test(Rank k) const {
+        if (k < 0) return false;
+        int i = findKey((unsigned short)(k >> 16));
+        return i >= 0 && contains(_cont[i], k & 0xFFFF);
+    }
+
+    // kλΪ1Ƿ¼
+    bool set(Rank k) {
+        if (k < 0) return false;
+        int i = findKey((unsigned short)(k >> 16));
+        if (i < 0) {
+            i = -i - 1;
+            _keys.insert(_keys.begin() + i, (unsigned short)(k >> 16));
+            _cont.insert(_cont.begin() + i, Container());
+        }
+        return add(_cont[i], k & 0xFFFF);
+    }
+
+    // kλΪ0ǷԭΪ1ʱͷ
+    bool clear(Rank k) {
+        if (k < 0) return false;
+        int i = findKey((unsigned short)(k >> 16));
+        if (i < 0 || !remove(_cont[i], k & 0xFFFF)) return false;
+        if (_cont[i].card == 0) {
+            _keys.erase(_keys.begin() + i);
+            _cont.erase(_cont.begin() + i);
+        }
+        return true;
+    }
+
+    // ÿȽֱʾĴСʡռһ֣ĿתΪγ
+    void runOptimize() {
+        std::vector<BitWord> w(CHUNK_WORDS);
+        for (size_t i = 0; i < _cont.size(); i++) {
+            Container& c = _cont[i];
+            toWords(c, &w[0]);
+            // ͳγ̣߼˳£ֵΪ1ǰһλΪ0λһγ̵
+            int nRuns = 0;
+            BitWord carry = 0;  // ǰһֵһλ
+            for (int j = 0; j < CHUNK_WORDS; j++) {
+                BitWord x = bitmapOrder(w[j]);
+                nRuns += bitmapPopcount(x & ~((x >> 1) | (carry << 63)));
+                carry = x & 1;
+            }
+            size_t runBytes = 4 * (size_t)nRuns;
+            size_t plainBytes = (c.card <= ARRAY_MAX) ? 2 * (size_t)c.card : 8 * (size_t)CHUNK_WORDS;
+            if (runBytes < plainBytes) {
+                if (c.type == RUN_CONTAINER) continue;
+                std::vector<unsigned short> runs;
+                runs.reserve(2 * nRuns);
+                int start = -1;
+                for (int v = 0; v <= CHUNK_BITS; v++) {
+                    bool on = v < CHUNK_BITS && (w[v >> 6] & bitmapMask(v));
+                    if (on && start < 0) start = v;
+                    if (!on && start >= 0) {
+                        runs.push_back((unsigned short)start);
+                        runs.push_back((unsigned short)(v - 1 - start));
+                        start = -1;
+                    }
+                }
+                c.type = RUN_CONTAINER;
+                c.runs.swap(runs);
+                std::vector<unsigned short>().swap(c.array);
+                std::vector<BitWord>().swap(c.bits);
+            } else if (c.type == RUN_CONTAINER) {
+                fromWords(c, &w[0]);
+            }
+        }
+    }
+
+    // ͵أŹ鲢ֻ߶еĿ
+    RoaringBitmap& operator|=(const RoaringBitmap& o) {
+        RoaringBitmap r;
+        size_t i = 0, j = 0;
+        while (i < _keys.size() || j < o._keys.size()) {
+            if (j == o._keys.size() || (i < _keys.size() && _keys[i] < o._keys[j])) {
+                r._keys.push_back(_keys[i]);
+                r._cont.push_back(_cont[i++]);
+            } else if (i == _keys.size() || o._keys[j] < _keys[i]) {
+                r._keys.push_back(o._keys[j]);
+                r._cont.push_back(o._cont[j++]);
+            } else {
+                r._keys.push_back(_keys[i]);
+                r._cont.push_back(Container());
+                unite(_cont[i++], o._cont[j++], r._cont.back());
+            }
+        }
+        swap(r);
+        return *this;
+    }
+
+    RoaringBitmap& operator&=(const RoaringBitmap& o) {
+        RoaringBitmap r;
+        size_t i = 0, j = 0;
+        while (i < _keys.size() && j < o._keys.size()) {
+            if (_keys[i] < o._keys[j]) {
+                i++;
+            } else if (o._keys[j] < _keys[i]) {
+                j++;
+            } else {
+                Container c;
+                intersect(_cont[i], o._cont[j], c);
+                if (c.card > 0) {
+                    r._keys.push_back(_keys[i]);
+                    r._cont.push_back(Container());
+                    r._cont.back().type = c.type;
+                    r._cont.back().card = c.card;
+                    r._cont.back().array.swap(c.array);
+                    r._cont.back().bits.swap(c.bits);
+                }
+                i++;
+                j++;
+            }
+        }
+        swap(r);
+        return *this;
+    }
+
+    void swap(RoaringBitmap& o) {
+        _keys.swap(o._keys);
+        _cont.swap(o._cont);
+    }
+
+    // ȴС󣬶ÿֵΪ1λkvisit(k)
+    template <typename VST>
+    void traverse(VST& visit) const {
+        for (size_t i = 0; i < _keys.size(); i++) {
+            Rank base = (Rank)_keys[i] << 16;
+            const Container& c = _cont[i];
+            if (c.type == ARRAY_CONTAINER) {
+                for (size_t j = 0; j < c.array.size(); j++) visit(base + c.array[j]);
+            } else if (c.type == RUN_CONTAINER) {
+                for (size_t r = 0; r < c.runs.size(); r += 2) {
+                    for (Rank v = c.runs[r]; v <= (Rank)c.runs[r] + c.runs[r + 1]; v++) visit(base + v);
+                }
+            } else {
+                for (int j = 0; j < CHUNK_WORDS; j++) {
+                    for (BitWord x = bitmapOrder(c.bits[j]); x != 0; x &= ~(0x8000000000000000ULL >> bitmapClz(x))) {
+                        visit(base + 64 * j + bitmapClz(x));
+                    }
+                }
+            }
+        }
+    }
+
+    // ĸ
+    int containerCount(int type) const {
+        int n = 0;
+        for (size_t i = 0; i < _cont.size(); i++) n += (_cont[i].type == type);
+        return n;
+    }
+
+    // ռõֽ
+    size_t memoryUsage() const {
+        size_t bytes = sizeof(*this) + _keys.capacity() * sizeof(unsigned short);
+        for (size_t i = 0; i < _cont.size(); i++) bytes += containerBytes(_cont[i]);
+        return bytes;
+    }
+};
+
+// Ǿ͵صĲ
+inline RoaringBitmap operator|(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap c(a);
+    return c |= b;
+}
+
+inline RoaringBitmap operator&(const RoaringBitmap& a, const RoaringBitmap& b) {
+    RoaringBitmap c(a);
+    return c &= b;
+}
+
+// ܲԣϡ衢RoaringBitmapڴٶ
+inline void benchRoaring() {
+    printf("\n=== ѹλͼ ===\n");
+    const char* names[] = {"ϡ裨5000ֲ2^27ڣ", "ܣ2^22Լһ룩", "䣨100Σÿ2"};
+    srand(17);
+    for (int kind = 0; kind < 3; kind++) {
+        std::vector<Rank> a, b;
+        if (kind == 0) {
+            for (int i = 0; i < 5000; i++) {
+                a.push_back((Rank)(((long long)rand() * RAND_MAX + rand()) % (1 << 27)));
+                b.push_back((Rank)(((long long)rand() * RAND_MAX + rand()) % (1 << 27)));
+            }
+        } else if (kind == 1) {
+            for (int i = 0; i < (1 << 21); i++) {
+                a.push_back((Rank)(((long long)rand() * RAND_MAX + rand()) % (1 << 22)));
+                b.push_back((Rank)(((long long)rand() * RAND_MAX + rand()) % (1 << 22)));
+            }
+        } else {
+            for (int r = 0; r < 100; r++) {
+                Rank s = r * 100000, t = r * 100000 + 50000;
+                for (Rank k = 0; k < 20000; k++) {
+                    a.push_back(s + k);
+                    b.push_back(t + k);
+                }
+            }
+        }
+
+        clock_t t0 = clock();
+        Bitmap ba, bb;
+        for (size_t i = 0; i < a.size(); i++) ba.set(a[i]);
+        for (size_t i = 0; i < b.size(); i++) bb.set(b[i]);
+        double bitmapSet = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        t0 = clock();
+        RoaringBitmap ra, rb;
+        for (size_t i = 0; i < a.size(); i++) ra.set(a[i]);
+        for (size_t i = 0; i < b.size(); i++) rb.set(b[i]);
+        ra.runOptimize();
+        rb.runOptimize();
+        double roaringSet = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        size_t bitmapBytes = ba.wordCount() * sizeof(BitWord), roaringBytes = ra.memoryUsage();
+
+        t0 = clock();
+        long long hit1 = 0;
+        for (size_t i = 0; i < b.size(); i++) hit1 += ba.test(b[i]);
+        double bitmapTest = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        t0 = clock();
+        long long hit2 = 0;
+        for (size_t i = 0; i < b.size(); i++) hit2 += ra.test(b[i]);
+        double roaringTest = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        t0 = clock();
+        Bitmap bu = ba | bb, bi = ba & bb;
+        double bitmapOps = (double)(clock() - t0) / CLOCKS_PER_SEC;
+        t0 = clock();
+        RoaringBitmap ru = ra | rb, ri = ra & rb;
+        double roaringOps = (double)(clock() - t0) / CLOCKS_PER_SEC;
+
+        Bitmap back;
+        ru.toBitmap(back);
+        bool same = (hit1 == hit2 && ra.size() == ba.size() && ru.size() == bu.size() && ri.size() == bi.size() &&
+                     (back ^ bu).size() == 0 && RoaringBitmap(bu).size() == ru.size());
+        printf("%s\n", names[kind]);
+        printf("  ڴ棺Bitmap %.1f KBRoaring %.1f KB%d/λͼ%d/γ%d飩\n",
+               bitmapBytes / 1024.0, roaringBytes / 1024.0,
+               ra.containerCount(RoaringBitmap::ARRAY_CONTAINER), ra.containerCount(RoaringBitmap::BITMAP_CONTAINER),
+               ra.containerCount(RoaringBitmap::RUN_CONTAINER));
+        printf("  Bitmap %.4f 룬Roaring %.4f 룻ѯBitmap %.4f 룬Roaring %.4f \n", bitmapSet,
+               roaringSet, bitmapTest, roaringTest);
+        printf("  +Bitmap %.4f 룬Roaring %.4f 루%s\n", bitmapOps, roaringOps, same ? "һ" : "һ");
+    }
+}
+
+#endif // ROARING_BITMAP_H
@@ -1,4 +1,11 @@
 #include "HuffTree.h"
+#include "BitmapRank.h"
+#include "RoaringBitmap.h"
+#include "LazyBitmap.h"
+#include "BloomFilter.h"
+#include "AtomicBitmap.h"
+#include "PrimeSieve.h"
+#include "HuffCodec.h"
 #include <iostream>
 #include <cstring>
 #include <cstddef>  // NULL
@@ -39,7 +46,32 @@ void countFreqFromDream(int freq[26]) {
     freq['z' - 'a'] = 1;  // z1 
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // benchʱֻܲ
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchBinTreeArena();
+        benchBitmap();
+        benchBitmapOps();
+        benchBitmapFile();
+        benchBitmapRank();
+        benchBitmapRank(1 << 26, 1000000, 1 << 12);  // ϡ裺һԽ
+        benchRoaring();
+        benchLazyBitmap();
+        benchBloomFilter();
+        benchAtomicBitmap();
+        benchPrimeSieve();
+        benchHuffCodec();
+        return 0;
+    }
+    // ļѹ/ѹmain compress <> <>main decompress <> <>
+    if (argc > 1 && (strcmp(argv[1], "compress") == 0 || strcmp(argv[1], "decompress") == 0)) {
+        if (argc != 4) {
+            fprintf(stderr, "Usage: %s compress|decompress <input> <output>\n", argv[0]);
+            return 1;
+        }
+        return huffFile(argv[2], argv[3], strcmp(argv[1], "compress") == 0) ? 0 : 1;
+    }
+
     // 1. ͳơI have a dream26ĸƵ
     int charFreq[26];
     countFreqFromDream(charFreq);
@@ -68,6 +100,17 @@ int main() {
         cout << targetWords[i] << " Huffman룺" << code << endl;
         delete[] code; // ͷűַڴ
     }
+    cout << endl;
+
+    // 6. ֤ԭ
+    HuffDecoder decoder(encoder);
+    cout << "=== ʽ ===" << endl;
+    for (int i = 0; targetWords[i] != NULL; i++) {
+        vector<BitWord> words;
+        int bits = encoder.encode(targetWords[i], words);
+        cout << bits << " ؽΪ" << decoder.decodeWord(words, bits) << endl;
+    }
+    cout << "ԣ" << (testHuffDecoder() ? "ͨ" : "ʧ") << endl;
 
     return 0;
 }